@@ -0,0 +1,232 @@
+/* Project: PR QuadTrees
+* analyze.c :
+*            = implementation of the module analyze of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "analyze.h"
+#include "quadtree.h"
+#include "trace.h"
+
+// nodes of a type at every depth
+typedef struct analyzeHistogram {
+    int* counts;  // counts[i] nodes at depth or of size i
+    int size;
+} analyzeHistogram_t;
+
+// leaf reported as one of the deepest
+typedef struct analyzeLeaf {
+    qTreeNode_t* leaf;
+    int depth;
+    unsigned char* path;  // quadrant codes from the root down to `leaf`
+} analyzeLeaf_t;
+
+// what a walk of a qTree found
+typedef struct analysis {
+    int nInner;
+    int nPointLeaves;
+    int nEmptyLeaves;
+    int maxFootpaths;
+    long nFootpaths;
+    analyzeHistogram_t inner;  // by depth
+    analyzeHistogram_t pointLeaves;  // by depth
+    analyzeHistogram_t emptyLeaves;  // by depth
+    analyzeHistogram_t leafSizes;  // point leaves by number of footpaths
+    analyzeLeaf_t deepest[ANALYZE_DEEPEST];  // deepest first
+    int nDeepest;
+    trace_t* path;  // quadrant codes from the root to the node being walked
+} analysis_t;
+
+// adds one to `histogram` at `i`
+static void analyzeCount(analyzeHistogram_t* histogram, int i) {
+    if (i >= histogram->size) {
+        int size = histogram->size;
+        while (histogram->size <= i)
+            histogram->size *= 2;
+        histogram->counts = realloc(histogram->counts, histogram->size * sizeof(*histogram->counts));
+        assert(histogram->counts);
+        memset(histogram->counts + size, 0, (histogram->size - size) * sizeof(*histogram->counts));
+    }
+    histogram->counts[i]++;
+}
+
+// returns the highest index of `histogram` counted, -1 if none was
+static int analyzeLast(analyzeHistogram_t* histogram) {
+    int last = histogram->size - 1;
+    while (last >= 0 && histogram->counts[last] == 0)
+        last--;
+    return last;
+}
+
+// keeps `leaf` at `depth` in the deepest leaves of `analysis` if it is deep enough
+// leaves found first are kept over later leaves at the same depth
+static void analyzeDeepest(analysis_t* analysis, qTreeNode_t* leaf, int depth) {
+    if (analysis->nDeepest == ANALYZE_DEEPEST && analysis->deepest[ANALYZE_DEEPEST - 1].depth >= depth)
+        return;
+
+    int i = analysis->nDeepest < ANALYZE_DEEPEST ? analysis->nDeepest++ : ANALYZE_DEEPEST - 1;
+    free(analysis->deepest[i].path);
+    for (; i > 0 && analysis->deepest[i - 1].depth < depth; i--)
+        analysis->deepest[i] = analysis->deepest[i - 1];
+
+    analysis->deepest[i].leaf = leaf;
+    analysis->deepest[i].depth = depth;
+    analysis->deepest[i].path = malloc(depth > 0 ? depth : 1);
+    assert(analysis->deepest[i].path);
+    memcpy(analysis->deepest[i].path, analysis->path->codes, depth);
+}
+
+// recursively walks `node` at `depth` adding it to `analysis`
+static void analyzeNode(analysis_t* analysis, qTreeNode_t* node, int depth) {
+    if (node->NW != NULL) {
+        analysis->nInner++;
+        analyzeCount(&analysis->inner, depth);
+
+        for (int quadrant = 0; quadrant < 4; quadrant++) {
+            traceAppend(analysis->path, quadrant);
+            analyzeNode(analysis, getQuadrant(node, quadrant), depth + 1);
+            analysis->path->n--;
+        }
+        return;
+    }
+
+    if (node->point == NULL) {
+        analysis->nEmptyLeaves++;
+        analyzeCount(&analysis->emptyLeaves, depth);
+        return;
+    }
+
+    int nFootpaths = node->footpaths->n;
+    analysis->nPointLeaves++;
+    analysis->nFootpaths += nFootpaths;
+    if (nFootpaths > analysis->maxFootpaths)
+        analysis->maxFootpaths = nFootpaths;
+    analyzeCount(&analysis->pointLeaves, depth);
+    analyzeCount(&analysis->leafSizes, nFootpaths);
+    analyzeDeepest(analysis, node, depth);
+}
+
+// returns the depth of the deepest node of any type in `analysis`
+static int analyzeMaxDepth(analysis_t* analysis) {
+    int last = analyzeLast(&analysis->inner);
+    if (analyzeLast(&analysis->pointLeaves) > last)
+        last = analyzeLast(&analysis->pointLeaves);
+    if (analyzeLast(&analysis->emptyLeaves) > last)
+        last = analyzeLast(&analysis->emptyLeaves);
+    return last;
+}
+
+// prints nodes by depth of `inner`, `pointLeaves` and `emptyLeaves` as a JSON array
+static void analyzePrintDepths(analysis_t* analysis, FILE* outFile) {
+    int last = analyzeMaxDepth(analysis);
+
+    fprintf(outFile, "  \"depths\": [\n");
+    for (int depth = 0; depth <= last; depth++) {
+        int inner = depth < analysis->inner.size ? analysis->inner.counts[depth] : 0;
+        int pointLeaves = depth < analysis->pointLeaves.size ? analysis->pointLeaves.counts[depth] : 0;
+        int emptyLeaves = depth < analysis->emptyLeaves.size ? analysis->emptyLeaves.counts[depth] : 0;
+        fprintf(outFile, "    {\"depth\": %d, \"inner\": %d, \"pointLeaves\": %d, \"emptyLeaves\": %d}%s\n",
+                depth, inner, pointLeaves, emptyLeaves, depth < last ? "," : "");
+    }
+    fprintf(outFile, "  ],\n");
+}
+
+// prints point leaves by number of footpaths of `analysis` as a JSON array
+static void analyzePrintLeafSizes(analysis_t* analysis, FILE* outFile) {
+    int last = analyzeLast(&analysis->leafSizes);
+
+    fprintf(outFile, "  \"footpathsPerLeaf\": {\n");
+    fprintf(outFile, "    \"mean\": %.3f,\n", analysis->nPointLeaves > 0 ?
+            (double)analysis->nFootpaths / analysis->nPointLeaves : 0.0);
+    fprintf(outFile, "    \"max\": %d,\n", analysis->maxFootpaths);
+    fprintf(outFile, "    \"histogram\": [");
+    int first = 1;
+    for (int size = 0; size <= last; size++) {
+        if (analysis->leafSizes.counts[size] == 0)
+            continue;
+        fprintf(outFile, "%s\n      {\"footpaths\": %d, \"leaves\": %d}", first ? "" : ",",
+                size, analysis->leafSizes.counts[size]);
+        first = 0;
+    }
+    fprintf(outFile, "%s]\n  },\n", first ? "" : "\n    ");
+}
+
+// prints the deepest leaves of `analysis` with their points and quadrant paths as a JSON array
+static void analyzePrintDeepest(analysis_t* analysis, FILE* outFile) {
+    fprintf(outFile, "  \"deepestLeaves\": [");
+    for (int i = 0; i < analysis->nDeepest; i++) {
+        analyzeLeaf_t* deepest = &analysis->deepest[i];
+        fprintf(outFile, "%s\n    {\"depth\": %d, \"x\": %.15g, \"y\": %.15g, \"footpaths\": %d, \"path\": \"",
+                i == 0 ? "" : ",", deepest->depth, deepest->leaf->point->x, deepest->leaf->point->y,
+                deepest->leaf->footpaths->n);
+        for (int d = 0; d < deepest->depth; d++)
+            fprintf(outFile, "%s%s", d == 0 ? "" : " ", quadrantLabel(deepest->path[d]));
+        fprintf(outFile, "\"}");
+    }
+    fprintf(outFile, "%s],\n", analysis->nDeepest > 0 ? "\n  " : "");
+}
+
+// prints the bytes of memory used by every structure of `qTree` as a JSON object
+static void analyzePrintMemory(qTree_t* qTree, FILE* outFile) {
+    qTreeMemory_t memory;
+    qTreeMemoryUsage(qTree, &memory);
+
+    fprintf(outFile, "  \"bytes\": {\n");
+    fprintf(outFile, "    \"nodes\": %zu,\n", memory.nodes);
+    fprintf(outFile, "    \"points\": %zu,\n", memory.points);
+    fprintf(outFile, "    \"rectangles\": %zu,\n", memory.rectangles);
+    fprintf(outFile, "    \"footpathArrays\": %zu,\n", memory.footpathArrays);
+    fprintf(outFile, "    \"records\": %zu,\n", memory.records);
+    fprintf(outFile, "    \"strings\": %zu,\n", memory.strings);
+    fprintf(outFile, "    \"total\": %zu\n", qTreeMemoryTotal(&memory));
+    fprintf(outFile, "  }\n");
+}
+
+// prints a report of the shape of `qTree` as JSON to `outFile`: nodes by type,
+// nodes by depth, leaves by number of footpaths, the fraction of children left
+// empty by splits, the deepest leaves with their points and quadrant paths, and
+// the bytes of memory used by every structure
+void qTreeAnalyze(qTree_t* qTree, FILE* outFile) {
+    analysis_t analysis;
+    memset(&analysis, 0, sizeof(analysis));
+
+    analyzeHistogram_t* histograms[] = {&analysis.inner, &analysis.pointLeaves,
+                                        &analysis.emptyLeaves, &analysis.leafSizes};
+    for (int i = 0; i < 4; i++) {
+        histograms[i]->size = ANALYZE_INIT_SIZE;
+        histograms[i]->counts = calloc(ANALYZE_INIT_SIZE, sizeof(*histograms[i]->counts));
+        assert(histograms[i]->counts);
+    }
+    analysis.path = traceCreate();
+
+    analyzeNode(&analysis, qTree->root, 0);
+
+    int nNodes = analysis.nInner + analysis.nPointLeaves + analysis.nEmptyLeaves;
+    fprintf(outFile, "{\n");
+    fprintf(outFile, "  \"nodes\": {\"total\": %d, \"inner\": %d, \"pointLeaves\": %d, \"emptyLeaves\": %d},\n",
+            nNodes, analysis.nInner, analysis.nPointLeaves, analysis.nEmptyLeaves);
+    fprintf(outFile, "  \"maxDepth\": %d,\n", analyzeMaxDepth(&analysis));
+
+    // every split makes four children, the empty ones only cost memory and a step
+    fprintf(outFile, "  \"emptyChildFraction\": %.4f,\n", analysis.nInner > 0 ?
+            (double)analysis.nEmptyLeaves / (4.0 * analysis.nInner) : 0.0);
+
+    analyzePrintDepths(&analysis, outFile);
+    analyzePrintLeafSizes(&analysis, outFile);
+    analyzePrintDeepest(&analysis, outFile);
+    analyzePrintMemory(qTree, outFile);
+    fprintf(outFile, "}\n");
+
+    for (int i = 0; i < 4; i++)
+        free(histograms[i]->counts);
+    for (int i = 0; i < analysis.nDeepest; i++)
+        free(analysis.deepest[i].path);
+    traceFree(analysis.path);
+}
@@ -0,0 +1,28 @@
+/* Project: PR QuadTrees
+* analyze.h :
+*            = interface of the module analyze of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _ANALYZE_H_
+#define _ANALYZE_H_
+
+#include <stdio.h>
+
+#include "quadtree.h"
+
+// number of deepest leaves reported with their quadrant paths
+#define ANALYZE_DEEPEST 5
+
+// initial number of depths and leaf sizes a histogram has room for
+#define ANALYZE_INIT_SIZE 32
+
+// prints a report of the shape of `qTree` as JSON to `outFile`: nodes by type,
+// nodes by depth, leaves by number of footpaths, the fraction of children left
+// empty by splits, the deepest leaves with their points and quadrant paths, and
+// the bytes of memory used by every structure
+void qTreeAnalyze(qTree_t* qTree, FILE* outFile);
+
+#endif
@@ -25,11 +25,9 @@ array_t *arrayCreate() {
 	return arr;
 }
 
-// free memory used by array "arr"
-void arrayFree(array_t *arr) {
-	for (int i = 0; i < arr->n; i++) {
-		footpathFree(arr->A[i]);
-	}
+// free memory used by array "arr" but not the footpaths it points to
+// footpaths are owned by the store holding their rows
+void arrayFreeShallow(array_t *arr) {
 	free(arr->A);
 	free(arr);
 }
@@ -71,6 +69,45 @@ void sortedArrayInsert(array_t *arr, footpath_t *footpath) {
 	arr->n++;
 }
 
+// appends data "footpath" to the end of array "arr", "arr" may become unsorted
+void arrayAppend(array_t *arr, footpath_t *footpath) {
+	arrayEnableInsert(arr);
+	arr->A[arr->n++] = footpath;
+}
+
+// compares footpaths pointed to by "a" and "b" by id, for qsort
+int arrayCmpID(const void *a, const void *b) {
+	return footpathCmpID(*(footpath_t **)a, *(footpath_t **)b);
+}
+
+// sorts array "arr" by footpathID
+void arraySort(array_t *arr) {
+	qsort(arr->A, arr->n, sizeof(*(arr->A)), arrayCmpID);
+}
+
+// removes the footpath with "id" from sorted array "arr"
+// returns the pointer to the removed footpath, NULL if not found
+footpath_t *arrayRemove(array_t *arr, int id) {
+	int mid, lo = 0, hi = arr->n - 1;
+	while (lo <= hi) {
+		mid = (lo + hi)/2;
+		int cmp = id - footpathGetID(arr->A[mid]);
+		if (cmp == 0) {
+			footpath_t *footpath = arr->A[mid];
+			// shift all elements after the removed one position to the left
+			memmove(arr->A + mid, arr->A + mid + 1, (arr->n - mid - 1) * sizeof(*(arr->A)));
+			arr->n--;
+			return footpath;
+		}
+		if (cmp < 0) {
+			hi = mid - 1;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	return NULL;
+}
+
 // searches for footpath with "id" in sorted array "arr"
 // returns the pointer to the found footpath, NULL if not found
 footpath_t *arrayBinarySearch(array_t *arr, int id) {
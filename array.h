@@ -22,12 +22,23 @@ typedef struct array {
 // creates & returns an empty array
 array_t *arrayCreate();
 
-// free memory used by array "arr"
-void arrayFree(array_t *arr);
+// free memory used by array "arr" but not the footpaths it points to
+// footpaths are owned by the store holding their rows
+void arrayFreeShallow(array_t *arr);
 
 // inserts data "footpath" into array "arr", ensuring "arr" is sorted 
 void sortedArrayInsert(array_t *arr, footpath_t *footpath);
 
+// appends data "footpath" to the end of array "arr", "arr" may become unsorted
+void arrayAppend(array_t *arr, footpath_t *footpath);
+
+// sorts array "arr" by footpathID
+void arraySort(array_t *arr);
+
+// removes the footpath with "id" from sorted array "arr"
+// returns the pointer to the removed footpath, NULL if not found
+footpath_t *arrayRemove(array_t *arr, int id);
+
 // searches for footpath with "id" in sorted array "arr"
 // returns the pointer to the found footpath, NULL if not found
 footpath_t *arrayBinarySearch(array_t *arr, int id);
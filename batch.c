@@ -0,0 +1,121 @@
+/* Project: PR QuadTrees
+* batch.c :
+*            = implementation of the module batch of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "batch.h"
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+
+// state shared by every node of a batched walk
+typedef struct batch {
+    rectangle_t** ranges;
+    trace_t** traces;
+    array_t** found;  // footpaths found by every range, unsorted and with duplicates
+    // ranges still overlapping each node on the path from the root,
+    // a frame of ranges per level one after the other
+    int* active;
+    int nActive;
+    int size;
+} batch_t;
+
+// recursively searches `node` for points within the `n` ranges of the frame
+// starting at `frame` of the active ranges of `batch`
+static void batchNode(batch_t* batch, qTreeNode_t* node, int frame, int n) {
+    // frame of the ranges overlapping `node` is pushed after the frame of its parent
+    if (batch->nActive + n > batch->size) {
+        batch->size = 2 * (batch->nActive + n);
+        batch->active = realloc(batch->active, batch->size * sizeof(*batch->active));
+        assert(batch->active);
+    }
+
+    int start = batch->nActive;
+    for (int i = frame; i < frame + n; i++) {
+        int query = batch->active[i];
+        if (rectangleOverlap(node->rectangle, batch->ranges[query]))
+            batch->active[batch->nActive++] = query;
+    }
+    int nOverlapping = batch->nActive - start;
+
+    if (nOverlapping > 0) {
+        // not an empty leaf node so append current quadrant to every trace
+        if (batch->traces != NULL && !(node->NW == NULL && node->point == NULL)) {
+            for (int i = start; i < start + nOverlapping; i++)
+                traceAppend(batch->traces[batch->active[i]], node->quadrant);
+        }
+
+        if (node->point != NULL) {
+            for (int i = start; i < start + nOverlapping; i++) {
+                int query = batch->active[i];
+                if (inRectangleStage4(batch->ranges[query], node->point)) {
+                    for (int j = 0; j < node->footpaths->n; j++)
+                        arrayAppend(batch->found[query], node->footpaths->A[j]);
+                }
+            }
+        }
+
+        if (node->NW) {
+            // children are fetched while the first of them is searched
+            __builtin_prefetch(node->NW);
+            __builtin_prefetch(node->NE);
+            __builtin_prefetch(node->SE);
+
+            // same order as queryRange so traces match
+            batchNode(batch, node->SW, start, nOverlapping);
+            batchNode(batch, node->NW, start, nOverlapping);
+            batchNode(batch, node->NE, start, nOverlapping);
+            batchNode(batch, node->SE, start, nOverlapping);
+        }
+    }
+
+    // popping the frame of `node`
+    batch->nActive = start;
+}
+
+// searches `qTree` for points within every one of the `nRanges` `ranges` in one
+// walk of `qTree`, every node is visited once for all ranges overlapping it
+// stores unique footpaths within `ranges[i]` into `results[i]` sorted by footpathID
+// and the quadrants visited into `traces[i]` as queryRange does, `traces` may be NULL
+array_t** qTreeBatchRange(qTree_t* qTree, rectangle_t** ranges, int nRanges,
+                        trace_t** traces, array_t** results) {
+    batch_t batch;
+    batch.ranges = ranges;
+    batch.traces = traces;
+    batch.size = 2 * nRanges + 1;
+    batch.active = malloc(batch.size * sizeof(*batch.active));
+    batch.found = malloc((nRanges > 0 ? nRanges : 1) * sizeof(*batch.found));
+    assert(batch.active && batch.found);
+
+    // every range is active at the root
+    for (int i = 0; i < nRanges; i++) {
+        batch.active[i] = i;
+        batch.found[i] = arrayCreate();
+    }
+    batch.nActive = nRanges;
+
+    batchNode(&batch, qTree->root, 0, nRanges);
+
+    // footpaths are deduplicated once per range instead of keeping
+    // a sorted array of visited footpaths per range during the walk
+    for (int i = 0; i < nRanges; i++) {
+        array_t* found = batch.found[i];
+        arraySort(found);
+        for (int j = 0; j < found->n; j++) {
+            if (j == 0 || footpathGetID(found->A[j]) != footpathGetID(found->A[j - 1]))
+                arrayAppend(results[i], found->A[j]);
+        }
+        arrayFreeShallow(found);
+    }
+
+    free(batch.found);
+    free(batch.active);
+    return results;
+}
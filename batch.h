@@ -0,0 +1,23 @@
+/* Project: PR QuadTrees
+* batch.h :
+*            = interface of the module batch of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+
+// searches `qTree` for points within every one of the `nRanges` `ranges` in one
+// walk of `qTree`, every node is visited once for all ranges overlapping it
+// stores unique footpaths within `ranges[i]` into `results[i]` sorted by footpathID
+// and the quadrants visited into `traces[i]` as queryRange does, `traces` may be NULL
+array_t** qTreeBatchRange(qTree_t* qTree, rectangle_t** ranges, int nRanges,
+                        trace_t** traces, array_t** results);
+
+#endif
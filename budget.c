@@ -0,0 +1,129 @@
+/* Project: PR QuadTrees
+* budget.c :
+*            = implementation of the module budget of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "budget.h"
+#include "quadtree.h"
+#include "array.h"
+
+// creates and returns a token for a range query not started yet
+resumeToken_t* resumeTokenCreate() {
+    resumeToken_t* token = malloc(sizeof(*token));
+    assert(token);
+
+    token->size = TOKEN_INIT_SIZE;
+    token->stack = malloc(token->size * sizeof(*token->stack));
+    assert(token->stack);
+    token->n = 0;
+    token->started = 0;
+
+    return token;
+}
+
+// pushes `node` on the stack of `token`
+static void tokenPush(resumeToken_t* token, qTreeNode_t* node) {
+    if (token->n == token->size) {
+        token->size *= 2;
+        token->stack = realloc(token->stack, token->size * sizeof(*token->stack));
+        assert(token->stack);
+    }
+    token->stack[token->n++] = node;
+}
+
+// returns the microseconds since `start`
+static long budgetMicros(struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000000L + (now.tv_nsec - start->tv_nsec) / 1000;
+}
+
+// returns whether `footpath` stored at `point` is found there by a query of `range`
+// on a tree spanning `span`, every footpath is found at its start point if that
+// is within `range` and in the tree and at its end point otherwise
+static int budgetFoundAt(footpath_t* footpath, point_t* point, rectangle_t* range, rectangle_t* span) {
+    point_t start = {footpathGetStartLon(footpath), footpathGetStartLat(footpath)};
+    if (fabs(point->x - start.x) < EPSILON && fabs(point->y - start.y) < EPSILON)
+        return 1;
+
+    return !(inRectangleStage4(range, &start) && inRectangle(span, &start));
+}
+
+// searches `qTree` for points within `range` from where `token` left off until
+// the query is done or `budget` runs out, stores unique footpaths found into
+// `results` sorted by footpathID and where the query stopped into `token`
+// a footpath is only ever found by one call of the same query
+// returns 1 if the query was cut short and can be resumed with `token`, 0 if done
+int qTreeBudgetedRange(qTree_t* qTree, rectangle_t* range, queryBudget_t* budget,
+                    resumeToken_t* token, array_t* results) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if (!token->started) {
+        tokenPush(token, qTree->root);
+        token->started = 1;
+    }
+
+    int nodesVisited = 0;
+    array_t* found = arrayCreate();
+
+    while (token->n > 0) {
+        // budget is checked before taking the next node off the stack
+        if (budget->maxNodes > 0 && nodesVisited >= budget->maxNodes)
+            break;
+        if (budget->maxResults > 0 && found->n >= budget->maxResults)
+            break;
+        if (budget->maxMicros > 0 && nodesVisited % DEADLINE_CHECK_NODES == 0 && nodesVisited > 0 &&
+            budgetMicros(&start) >= budget->maxMicros)
+            break;
+
+        qTreeNode_t* node = token->stack[--token->n];
+        rectangle_t* span = node->rectangle;
+        if (node->count == 0 || span->topRightX < range->botLeftX || span->botLeftX > range->topRightX ||
+            span->topRightY < range->botLeftY || span->botLeftY > range->topRightY)
+            continue;
+
+        nodesVisited++;
+
+        if (node->point != NULL && inRectangleStage4(range, node->point)) {
+            for (int i = 0; i < node->footpaths->n; i++) {
+                footpath_t* footpath = node->footpaths->A[i];
+                if (budgetFoundAt(footpath, node->point, range, qTree->root->rectangle))
+                    arrayAppend(found, footpath);
+            }
+        }
+
+        // pushed in reverse so quadrants are searched in the order queryRange does
+        if (node->NW) {
+            tokenPush(token, node->SE);
+            tokenPush(token, node->NE);
+            tokenPush(token, node->NW);
+            tokenPush(token, node->SW);
+        }
+    }
+
+    // both points of a footpath starting and ending at the same point are in the same leaf
+    arraySort(found);
+    for (int i = 0; i < found->n; i++) {
+        if (i == 0 || footpathGetID(found->A[i]) != footpathGetID(found->A[i - 1]))
+            arrayAppend(results, found->A[i]);
+    }
+    arrayFreeShallow(found);
+
+    return token->n > 0;
+}
+
+// free allocated memory used by `token`
+void resumeTokenFree(resumeToken_t* token) {
+    free(token->stack);
+    free(token);
+}
@@ -0,0 +1,50 @@
+/* Project: PR QuadTrees
+* budget.h :
+*            = interface of the module budget of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _BUDGET_H_
+#define _BUDGET_H_
+
+#include "quadtree.h"
+#include "array.h"
+
+#define TOKEN_INIT_SIZE 64  // initial number of nodes a resume token can hold
+
+// nodes visited between two looks at the clock
+#define DEADLINE_CHECK_NODES 64
+
+// limits of a single call of qTreeBudgetedRange, 0 for no limit
+// limits are checked between nodes so a call may go over by one node
+typedef struct queryBudget {
+    int maxNodes;  // nodes visited
+    int maxResults;  // footpaths stored into the results
+    long maxMicros;  // microseconds from the start of the call
+} queryBudget_t;
+
+// nodes still to be searched by a range query, in the order they will be
+typedef struct resumeToken {
+    qTreeNode_t** stack;  // next node on top
+    int n;  // nodes on the stack
+    int size;  // nodes the stack can hold before growing
+    int started;  // whether the query has been started
+} resumeToken_t;
+
+// creates and returns a token for a range query not started yet
+resumeToken_t* resumeTokenCreate();
+
+// searches `qTree` for points within `range` from where `token` left off until
+// the query is done or `budget` runs out, stores unique footpaths found into
+// `results` sorted by footpathID and where the query stopped into `token`
+// a footpath is only ever found by one call of the same query
+// returns 1 if the query was cut short and can be resumed with `token`, 0 if done
+int qTreeBudgetedRange(qTree_t* qTree, rectangle_t* range, queryBudget_t* budget,
+                    resumeToken_t* token, array_t* results);
+
+// free allocated memory used by `token`
+void resumeTokenFree(resumeToken_t* token);
+
+#endif
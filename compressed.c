@@ -0,0 +1,209 @@
+/* Project: PR QuadTrees
+* compressed.c :
+*            = implementation of the module compressed of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+
+#include "compressed.h"
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+
+// appends quadrant `code` to the prefixes of `tree`
+static void compressedAppendCode(compressedTree_t* tree, int code) {
+    if (tree->prefixesUsed == tree->prefixesSize) {
+        tree->prefixesSize *= 2;
+        tree->prefixes = realloc(tree->prefixes, tree->prefixesSize);
+        assert(tree->prefixes);
+    }
+    tree->prefixes[tree->prefixesUsed++] = code;
+}
+
+// returns the only child of inner `node` holding points, NULL if there are more
+static qTreeNode_t* compressedOnlyChild(qTreeNode_t* node) {
+    qTreeNode_t* only = NULL;
+
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        qTreeNode_t* child = getQuadrant(node, quadrant);
+        if (child->count == 0)
+            continue;
+        if (only != NULL)
+            return NULL;
+        only = child;
+    }
+    return only;
+}
+
+// recursively adds the chain starting at `node`, `depth` nodes and `quadtreeDepth`
+// quadtree nodes below the root, and everything below it to `tree`
+// returns the index of the node added
+static int compressedAdd(compressedTree_t* tree, qTreeNode_t* node, int depth, int quadtreeDepth) {
+    if (tree->n == tree->size) {
+        tree->size *= 2;
+        tree->nodes = realloc(tree->nodes, tree->size * sizeof(*tree->nodes));
+        assert(tree->nodes);
+    }
+    int index = tree->n++;
+    int prefixOffset = tree->prefixesUsed;
+
+    // the root is kept as it is so searches start from its span
+    if (node->quadrant != NO_QUADRANT) {
+        compressedAppendCode(tree, node->quadrant);
+        qTreeNode_t* only;
+        while (node->NW != NULL && (only = compressedOnlyChild(node)) != NULL) {
+            node = only;
+            compressedAppendCode(tree, node->quadrant);
+        }
+    }
+
+    // nodes may move while the children are added so the node is filled in last
+    compressedNode_t compressed;
+    compressed.rectangle = *node->rectangle;
+    compressed.point = node->point != NULL ? *node->point : (point_t){0, 0};
+    compressed.footpaths = node->point != NULL ? node->footpaths : NULL;
+    compressed.prefixOffset = prefixOffset;
+    compressed.prefixLength = tree->prefixesUsed - prefixOffset;
+
+    quadtreeDepth += compressed.prefixLength;
+    if (depth + 1 > tree->depth)
+        tree->depth = depth + 1;
+    if (quadtreeDepth + 1 > tree->quadtreeDepth)
+        tree->quadtreeDepth = quadtreeDepth + 1;
+
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        qTreeNode_t* child = node->NW != NULL ? getQuadrant(node, quadrant) : NULL;
+        compressed.children[quadrant] = child != NULL && child->count > 0 ?
+            compressedAdd(tree, child, depth + 1, quadtreeDepth) : COMPRESSED_NONE;
+    }
+
+    tree->nodes[index] = compressed;
+    return index;
+}
+
+// builds a compressed quadtree of finalized `qTree`, which keeps
+// owning the footpaths and has to outlive the compressed quadtree
+compressedTree_t* compressedTreeBuild(qTree_t* qTree) {
+    // leaves only point to the footpath arrays of a finalized tree
+    assert(qTree->footpathPool != NULL);
+
+    compressedTree_t* tree = malloc(sizeof(*tree));
+    assert(tree);
+
+    // every inner node but the root has at least two children so there are
+    // fewer inner nodes than leaves
+    tree->size = 2 * qTree->nLeaves + 1;
+    tree->nodes = malloc(tree->size * sizeof(*tree->nodes));
+    tree->prefixesSize = tree->size;
+    tree->prefixes = malloc(tree->prefixesSize);
+    assert(tree->nodes && tree->prefixes);
+    tree->n = 0;
+    tree->prefixesUsed = 0;
+    tree->depth = 0;
+    tree->quadtreeDepth = 0;
+
+    compressedAdd(tree, qTree->root, 0, 0);
+
+    tree->nodes = realloc(tree->nodes, tree->n * sizeof(*tree->nodes));
+    tree->prefixes = realloc(tree->prefixes, tree->prefixesUsed > 0 ? tree->prefixesUsed : 1);
+    assert(tree->nodes && tree->prefixes);
+    tree->size = tree->n;
+    tree->prefixesSize = tree->prefixesUsed;
+
+    return tree;
+}
+
+// returns whether `node` is a leaf holding `point`
+static int compressedMatch(compressedNode_t* node, point_t* point) {
+    return node->footpaths != NULL && samePoint(&node->point, point);
+}
+
+// prints the footpaths of leaf `node` found for the point in `xBuffer` and `yBuffer`
+static void compressedPrint(compressedNode_t* node, FILE* infoFile, char* xBuffer, char* yBuffer) {
+    fprintf(infoFile, "%s %s\n", xBuffer, yBuffer);
+    for (int i = 0; i < node->footpaths->n; i++)
+        footpathPrint(node->footpaths->A[i], infoFile);
+}
+
+// searches `tree` for `point` as qTreeSearch does, appending the quadrants
+// of the quadtree accessed to reach `point` to `trace`, rebuilt from the chains
+// of the nodes passed, and printing its footpaths to `infoFile` if found
+void compressedTreeSearch(compressedTree_t* tree, point_t* point, trace_t* trace,
+                        FILE* infoFile, char* xBuffer, char* yBuffer) {
+    compressedNode_t* node = &tree->nodes[0];
+
+    // root as a leaf
+    if (node->footpaths != NULL) {
+        if (compressedMatch(node, point)) {
+            traceAppend(trace, NO_QUADRANT);
+            compressedPrint(node, infoFile, xBuffer, yBuffer);
+        }
+        return;
+    }
+
+    if (!inRectangle(&node->rectangle, point))
+        return;
+
+    while (1) {
+        int quadrant = rectangleQuadrant(&node->rectangle, point);
+        if (quadrant == -1 || node->children[quadrant] == COMPRESSED_NONE)
+            return;
+
+        compressedNode_t* child = &tree->nodes[node->children[quadrant]];
+        unsigned char* codes = tree->prefixes + child->prefixOffset;
+        int n = child->prefixLength;
+
+        if (!inRectangle(&child->rectangle, point)) {
+            // leaving the chain part way down, the quadtree nodes of the chain
+            // are walked without being stored until `point` takes another quadrant
+            rectangle_t span = rectangleQuadrantSpan(&node->rectangle, quadrant);
+            traceAppend(trace, codes[0]);
+            for (int i = 1; i < n - 1; i++) {
+                quadrant = rectangleQuadrant(&span, point);
+                if (quadrant != codes[i])
+                    return;
+                traceAppend(trace, codes[i]);
+                span = rectangleQuadrantSpan(&span, quadrant);
+            }
+            return;
+        }
+
+        // every inner quadtree node of the chain holds `point`
+        for (int i = 0; i < n - 1; i++)
+            traceAppend(trace, codes[i]);
+
+        if (child->footpaths != NULL) {
+            if (compressedMatch(child, point)) {
+                traceAppend(trace, codes[n - 1]);
+                compressedPrint(child, infoFile, xBuffer, yBuffer);
+            }
+            return;
+        }
+
+        traceAppend(trace, codes[n - 1]);
+        node = child;
+    }
+}
+
+// returns the bytes of memory used by the nodes of `tree`
+size_t compressedTreeNodeBytes(compressedTree_t* tree) {
+    return sizeof(*tree) + tree->size * sizeof(*tree->nodes);
+}
+
+// returns the bytes of memory used by the quadrant codes of the chains of `tree`
+size_t compressedTreePrefixBytes(compressedTree_t* tree) {
+    return tree->prefixesSize;
+}
+
+// free allocated memory used by `tree`
+void compressedTreeFree(compressedTree_t* tree) {
+    free(tree->nodes);
+    free(tree->prefixes);
+    free(tree);
+}
@@ -0,0 +1,64 @@
+/* Project: PR QuadTrees
+* compressed.h :
+*            = interface of the module compressed of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _COMPRESSED_H_
+#define _COMPRESSED_H_
+
+#include <stdio.h>
+
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+
+// child of a compressed node in a quadrant holding no points
+#define COMPRESSED_NONE -1
+
+// node of a compressed quadtree standing in for a chain of quadtree nodes
+// each with a single non empty quadrant, and the node ending the chain
+typedef struct compressedNode {
+    rectangle_t rectangle;  // span of the node ending the chain
+    point_t point;  // point of a leaf
+    array_t* footpaths;  // footpaths of a leaf in the finalized qTree, NULL for other nodes
+    int children[4];  // node below in each quadrant, COMPRESSED_NONE if empty
+    int prefixOffset;  // first quadrant code of the chain in the prefixes of the tree
+    int prefixLength;  // quadtree nodes in the chain, 0 for the root
+} compressedNode_t;
+
+// quadtree with every chain of nodes with a single non empty quadrant collapsed
+// into one node, so every inner node but the root splits the points below it
+typedef struct compressedTree {
+    compressedNode_t* nodes;  // nodes[0] is the root
+    int n;
+    int size;
+    unsigned char* prefixes;  // quadrant codes of the chains of every node
+    int prefixesUsed;
+    int prefixesSize;
+    int depth;  // most nodes on a path from the root down
+    int quadtreeDepth;  // most quadtree nodes on a path from the root down
+} compressedTree_t;
+
+// builds a compressed quadtree of finalized `qTree`, which keeps
+// owning the footpaths and has to outlive the compressed quadtree
+compressedTree_t* compressedTreeBuild(qTree_t* qTree);
+
+// searches `tree` for `point` as qTreeSearch does, appending the quadrants
+// of the quadtree accessed to reach `point` to `trace`, rebuilt from the chains
+// of the nodes passed, and printing its footpaths to `infoFile` if found
+void compressedTreeSearch(compressedTree_t* tree, point_t* point, trace_t* trace,
+                        FILE* infoFile, char* xBuffer, char* yBuffer);
+
+// returns the bytes of memory used by the nodes of `tree`
+size_t compressedTreeNodeBytes(compressedTree_t* tree);
+
+// returns the bytes of memory used by the quadrant codes of the chains of `tree`
+size_t compressedTreePrefixBytes(compressedTree_t* tree);
+
+// free allocated memory used by `tree`
+void compressedTreeFree(compressedTree_t* tree);
+
+#endif
@@ -0,0 +1,226 @@
+/* Project: PR QuadTrees
+* concurrent.c :
+*            = implementation of the module concurrent of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <sched.h>
+#include <pthread.h>
+#include <assert.h>
+
+#include "concurrent.h"
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+
+// footpaths inserted by one thread of qTreeConcurrentBuild
+typedef struct buildWork {
+    qTree_t* qTree;
+    array_t* footpaths;
+    int first;  // first footpath inserted, then every `stride`th one
+    int stride;
+} buildWork_t;
+
+// spinlock padded to a cache line so threads spinning on neighbouring stripes
+// don't share a line
+typedef struct leafLockStripe {
+    char lock;
+    char pad[CACHE_LINE - 1];
+} leafLockStripe_t;
+
+// spinlocks shared by every tree, each guarding the leaves whose address hashes to it
+static _Alignas(CACHE_LINE) leafLockStripe_t leafLocks[LOCK_STRIPES];
+
+// returns the spinlock guarding `node`
+static char* leafLock(qTreeNode_t* node) {
+    uintptr_t address = (uintptr_t)node;
+    return &leafLocks[(address >> 6 ^ address >> 18) % LOCK_STRIPES].lock;
+}
+
+// locks `lock`, yielding while another thread holds it
+static void spinLock(char* lock) {
+    while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(lock, __ATOMIC_RELAXED))
+            sched_yield();
+    }
+}
+
+// unlocks `lock`
+static void spinUnlock(char* lock) {
+    __atomic_clear(lock, __ATOMIC_RELEASE);
+}
+
+// splits leaf `node`, locked by the caller, into four quadrants holding its point
+// NW is published last so a thread seeing it sees every child complete
+static void concurrentSplit(qTreeNode_t* node) {
+    qTreeNode_t* children[4];
+    for (int quadrant = 0; quadrant < 4; quadrant++)
+        children[quadrant] = createQuadrant(node->rectangle, quadrant);
+
+    // children aren't shared yet so the point and footpaths of `node` move without locks
+    node->NE = children[1];
+    node->SW = children[2];
+    node->SE = children[3];
+    int quadrant = findQuadrant(node, node->point);
+    assert(quadrant != -1);
+
+    qTreeNode_t* child = children[quadrant];
+    child->point = node->point;
+    arrayFreeShallow(child->footpaths);
+    child->footpaths = node->footpaths;
+
+    node->footpaths = arrayCreate();
+    node->point = NULL;
+    __atomic_store_n(&node->NW, children[0], __ATOMIC_RELEASE);
+}
+
+// inserts `point` into `qTree` while other threads may be inserting into it too
+// inner nodes are descended without locks, a leaf is locked while a footpath is
+// added to it or it is split, and the children of a split leaf are published
+// only once they are complete, so concurrent inserts and
+// qTreeConcurrentCollect calls always see a consistent tree
+// counts of nodes aren't kept, qTreeFinalize recounts them
+// `qTree` can't be finalized or have an exact index or flat array of points
+// and `point` has to be within its root
+void qTreeConcurrentInsert(qTree_t* qTree, point_t* point, footpath_t* footpath) {
+    // nothing built over the nodes is kept up to date by concurrent inserts
+    assert(qTree->footpathPool == NULL && qTree->exactIndex == NULL && qTree->flatPoints == NULL);
+
+    // the root can't grow while other threads are below it
+    assert(inRectangle(qTree->root->rectangle, point));
+
+    qTreeNode_t* node = qTree->root;
+
+    while (1) {
+        // inner nodes never become leaves again so their children can be followed freely
+        if (__atomic_load_n(&node->NW, __ATOMIC_ACQUIRE) != NULL) {
+            int quadrant = findQuadrant(node, point);
+            node = getQuadrant(node, quadrant);
+            continue;
+        }
+
+        char* lock = leafLock(node);
+        spinLock(lock);
+
+        // split by another thread while waiting for the lock
+        if (node->NW != NULL) {
+            spinUnlock(lock);
+            continue;
+        }
+
+        if (node->point == NULL) {
+            node->point = point;
+            insertFootpathInArray(node->footpaths, footpath);
+            spinUnlock(lock);
+            return;
+        }
+
+        if (samePoint(node->point, point)) {
+            insertFootpathInArray(node->footpaths, footpath);
+            spinUnlock(lock);
+            free(point);
+            return;
+        }
+
+        // `point` goes into one of the new quadrants on the next pass
+        concurrentSplit(node);
+        spinUnlock(lock);
+    }
+}
+
+// inserts both the start and end point of `footpath` into `qTree` as
+// qTreeInsertFootpath does while other threads may be inserting into it too
+void qTreeConcurrentInsertFootpath(qTree_t* qTree, footpath_t* footpath) {
+    qTreeConcurrentInsert(qTree, newPoint(footpathGetStartLon(footpath), footpathGetStartLat(footpath)),
+                        footpath);
+    qTreeConcurrentInsert(qTree, newPoint(footpathGetEndLon(footpath), footpathGetEndLat(footpath)),
+                        footpath);
+}
+
+// appends the footpaths stored at `point` in `qTree` to `footpaths` while
+// other threads may be inserting into `qTree`, returns the number appended
+int qTreeConcurrentCollect(qTree_t* qTree, point_t* point, array_t* footpaths) {
+    qTreeNode_t* node = qTree->root;
+
+    while (1) {
+        if (__atomic_load_n(&node->NW, __ATOMIC_ACQUIRE) != NULL) {
+            int quadrant = findQuadrant(node, point);
+            if (quadrant == -1)
+                return 0;
+            node = getQuadrant(node, quadrant);
+            continue;
+        }
+
+        char* lock = leafLock(node);
+        spinLock(lock);
+
+        if (node->NW != NULL) {
+            spinUnlock(lock);
+            continue;
+        }
+
+        int n = 0;
+        if (node->point != NULL && samePoint(node->point, point)) {
+            for (; n < node->footpaths->n; n++)
+                arrayAppend(footpaths, node->footpaths->A[n]);
+        }
+        spinUnlock(lock);
+        return n;
+    }
+}
+
+// inserts the footpaths of the buildWork_t `arg`
+static void* concurrentBuildWork(void* arg) {
+    buildWork_t* work = arg;
+
+    for (int i = work->first; i < work->footpaths->n; i += work->stride)
+        qTreeConcurrentInsertFootpath(work->qTree, work->footpaths->A[i]);
+
+    return NULL;
+}
+
+// inserts every footpath in `footpaths` into `qTree` using `nThreads` threads
+// each taking every `nThreads`th footpath, the tree is the same for any `nThreads`
+// the root is grown to take every footpath first
+void qTreeConcurrentBuild(qTree_t* qTree, array_t* footpaths, int nThreads) {
+    assert(nThreads > 0);
+
+    // growing the root to take every point before any thread starts inserting
+    for (int i = 0; i < footpaths->n; i++) {
+        footpath_t* footpath = footpaths->A[i];
+        point_t start = {footpathGetStartLon(footpath), footpathGetStartLat(footpath)};
+        point_t end = {footpathGetEndLon(footpath), footpathGetEndLat(footpath)};
+        qTreeGrow(qTree, &start);
+        qTreeGrow(qTree, &end);
+    }
+
+    buildWork_t* work = malloc(nThreads * sizeof(*work));
+    pthread_t* threads = malloc(nThreads * sizeof(*threads));
+    assert(work && threads);
+
+    char* started = malloc(nThreads);
+    assert(started);
+
+    // footpaths no thread could be started for are inserted by the calling thread,
+    // alongside the threads that did start
+    for (int i = 0; i < nThreads; i++) {
+        work[i] = (buildWork_t){qTree, footpaths, i, nThreads};
+        started[i] = pthread_create(&threads[i], NULL, concurrentBuildWork, &work[i]) == 0;
+        if (!started[i])
+            concurrentBuildWork(&work[i]);
+    }
+    for (int i = 0; i < nThreads; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+    }
+
+    free(started);
+    free(threads);
+    free(work);
+}
@@ -0,0 +1,44 @@
+/* Project: PR QuadTrees
+* concurrent.h :
+*            = interface of the module concurrent of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _CONCURRENT_H_
+#define _CONCURRENT_H_
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+
+// number of spinlocks leaves are locked with, a leaf uses the one its address hashes to
+#define LOCK_STRIPES 4096
+// bytes each spinlock is padded to
+#define CACHE_LINE 64
+
+// inserts `point` into `qTree` while other threads may be inserting into it too
+// inner nodes are descended without locks, a leaf is locked while a footpath is
+// added to it or it is split, and the children of a split leaf are published
+// only once they are complete, so concurrent inserts and
+// qTreeConcurrentCollect calls always see a consistent tree
+// counts of nodes aren't kept, qTreeFinalize recounts them
+// `qTree` can't be finalized or have an exact index or flat array of points
+// and `point` has to be within its root
+void qTreeConcurrentInsert(qTree_t* qTree, point_t* point, footpath_t* footpath);
+
+// inserts both the start and end point of `footpath` into `qTree` as
+// qTreeInsertFootpath does while other threads may be inserting into it too
+void qTreeConcurrentInsertFootpath(qTree_t* qTree, footpath_t* footpath);
+
+// appends the footpaths stored at `point` in `qTree` to `footpaths` while
+// other threads may be inserting into `qTree`, returns the number appended
+int qTreeConcurrentCollect(qTree_t* qTree, point_t* point, array_t* footpaths);
+
+// inserts every footpath in `footpaths` into `qTree` using `nThreads` threads
+// each taking every `nThreads`th footpath, the tree is the same for any `nThreads`
+// the root is grown to take every footpath first
+void qTreeConcurrentBuild(qTree_t* qTree, array_t* footpaths, int nThreads);
+
+#endif
@@ -13,15 +13,16 @@
 #include <assert.h>
 
 #include "data.h"
+#include "store.h"
 
 // skip the header line of .csv file `f`
 void footpathSkipHeaderLine(FILE *f) {
 	while (fgetc(f) != '\n');
 }
 
-// reads a footpath from file "f" to build a footpath_t data.
+// reads a footpath from file "f" to build a footpathRecord_t data.
 // returns the pointer, or NULL if reading is unsuccessful.
-footpath_t *footpathRead(char* record) {
+footpathRecord_t *footpathRead(char* record) {
     // replace commas inside quotations because they should be retained
     replaceIncludedCommas(record);
     
@@ -46,7 +47,7 @@ footpath_t *footpathRead(char* record) {
     char startLon[MAX_CHARS + 1];
     char endLon[MAX_CHARS + 1];
 
-    footpath_t *footpath = malloc(sizeof(*footpath));
+    footpathRecord_t *footpath = malloc(sizeof(*footpath));
     assert(footpath);
 
     char* field;
@@ -198,36 +199,125 @@ void ensureStringFormat(char* string) {
 
 // compares 2 footpath "a" and "b" by id, returns -1, 0, +1 for < =, >  
 int footpathCmpID(footpath_t* a, footpath_t* b) {
-    if (a->footpathID < b->footpathID) return -1;
-	if (a->footpathID > b->footpathID) return +1;
+    int idA = footpathGetID(a), idB = footpathGetID(b);
+    if (idA < idB) return -1;
+	if (idA > idB) return +1;
 	return 0;
 }
 
 // getter to return footpathID from `footpath`
 int footpathGetID(footpath_t* footpath) {
-    return footpath->footpathID;
+    return footpathStoreGetID(footpath->store, footpath->row);
 }
 
-// prints a footpath record `*footpath` to file `outFile`
+// getters that return the coordinates of the start and end point of `footpath`
+double footpathGetStartLon(footpath_t* footpath) {
+    return footpath->store->startLon[footpath->row];
+}
+
+double footpathGetStartLat(footpath_t* footpath) {
+    return footpath->store->startLat[footpath->row];
+}
+
+double footpathGetEndLon(footpath_t* footpath) {
+    return footpath->store->endLon[footpath->row];
+}
+
+double footpathGetEndLat(footpath_t* footpath) {
+    return footpath->store->endLat[footpath->row];
+}
+
+// prints `footpath` to file `outFile`, reading its row from its store
 void footpathPrint(footpath_t *footpath, FILE *outFile) {
+    footpathStorePrint(footpath->store, footpath->row, outFile);
+}
+
+// prints a footpath record `*record` to file `outFile`
+void footpathRecordPrint(footpathRecord_t *record, FILE *outFile) {
     fprintf(outFile, "--> footpath_id: %d || address: %s || clue_sa: %s ||"
     " asset_type: %s || deltaz: %.2lf || distance: %.2lf || grade1in: %.1lf ||"
     " mcc_id: %d || mccid_int: %d || rlmax: %.2lf || rlmin: %.2lf || segside: %s"
     " || statusid: %d || streetid: %d || street_group: %d || start_lat: %lf ||"
     " start_lon: %lf || end_lat: %lf || end_lon: %lf || \n",
-    footpath->footpathID, footpath->address, footpath->clueSa,
-    footpath->assetType, footpath->deltaZ,footpath->distance,
-    footpath->grade1in, footpath->mccID, footpath->mccIDInt,
-    footpath->rlMax, footpath->rlMin, footpath->segSide, footpath->statusID,
-    footpath->streetID, footpath->streetGroup,footpath->startLat,
-    footpath->startLon, footpath->endLat, footpath->endLon);
-}
-
-// free allocated memory used to construct `footpath`
-void footpathFree(footpath_t *footpath) {
-    free(footpath->address);
-    free(footpath->clueSa);
-    free(footpath->assetType);
-    free(footpath->segSide);
-	free(footpath);
+    record->footpathID, record->address, record->clueSa,
+    record->assetType, record->deltaZ,record->distance,
+    record->grade1in, record->mccID, record->mccIDInt,
+    record->rlMax, record->rlMin, record->segSide, record->statusID,
+    record->streetID, record->streetGroup,record->startLat,
+    record->startLon, record->endLat, record->endLon);
+}
+
+// free allocated memory used to construct `record`
+void footpathRecordFree(footpathRecord_t *record) {
+    free(record->address);
+    free(record->clueSa);
+    free(record->assetType);
+    free(record->segSide);
+	free(record);
+}
+
+// writes string `string` to binary file `f` prefixed by its length
+// returns the number of bytes written
+static size_t stringWrite(char *string, FILE *f) {
+    int len = strlen(string);
+    size_t bytes = fwrite(&len, sizeof(len), 1, f) * sizeof(len);
+    return bytes + fwrite(string, sizeof(*string), len, f) * sizeof(*string);
+}
+
+// reads and returns a string written by stringWrite from binary file `f`
+// returns NULL if `f` ends before the string does
+static char* stringRead(FILE *f) {
+    int len;
+    if (fread(&len, sizeof(len), 1, f) != 1)
+        return NULL;
+
+    if (len < 0)
+        return NULL;
+
+    char *string = malloc(len + 1);
+    assert(string);
+    if (fread(string, sizeof(*string), len, f) != (size_t)len) {
+        free(string);
+        return NULL;
+    }
+    string[len] = '\0';
+
+    return string;
+}
+
+// writes `record` to binary file `f` so it can be read back by footpathReadBinary
+// returns the number of bytes written
+size_t footpathWrite(footpathRecord_t *record, FILE *f) {
+    // numeric fields are written as the raw struct, the string pointers
+    // in it are meaningless on disk and replaced when reading
+    size_t bytes = fwrite(record, sizeof(*record), 1, f) * sizeof(*record);
+    bytes += stringWrite(record->address, f);
+    bytes += stringWrite(record->clueSa, f);
+    bytes += stringWrite(record->assetType, f);
+    bytes += stringWrite(record->segSide, f);
+    return bytes;
+}
+
+// reads a footpath written by footpathWrite from binary file `f`
+// returns the pointer, or NULL if there are no more footpaths in `f`
+footpathRecord_t* footpathReadBinary(FILE *f) {
+    footpathRecord_t *record = malloc(sizeof(*record));
+    assert(record);
+
+    if (fread(record, sizeof(*record), 1, f) != 1) {
+        free(record);
+        return NULL;
+    }
+    record->address = stringRead(f);
+    record->clueSa = stringRead(f);
+    record->assetType = stringRead(f);
+    record->segSide = stringRead(f);
+
+    // a record cut short ends the file
+    if (!record->address || !record->clueSa || !record->assetType || !record->segSide) {
+        footpathRecordFree(record);
+        return NULL;
+    }
+
+    return record;
 }
@@ -12,7 +12,8 @@
 
 #define MAX_CHARS 128
 
-typedef struct footpath {
+// footpath as parsed from a row of the csv, before it is added to a footpathStore_t
+typedef struct footpathRecord {
     int footpathID;
     char *address;
     char *clueSa;
@@ -32,20 +33,38 @@ typedef struct footpath {
     double startLon;
     double endLat;
     double endLon;
+} footpathRecord_t;
+
+// footpath addressed by its row in the store holding it, one per row
+// so both points of a footpath share it
+typedef struct footpath {
+    struct footpathStore* store;
+    int row;
 } footpath_t;
 
 // skip the header line of .csv file `f`
 void footpathSkipHeaderLine(FILE *f);
 
-// reads a footpath from file "f" to build a footpath_t data.
+// reads a footpath from file "f" to build a footpathRecord_t data.
 // returns the pointer, or NULL if reading is unsuccessful.
-footpath_t* footpathRead(char* record);
+footpathRecord_t* footpathRead(char* record);
 
-// prints a footpath record `*footpath` to file `outFile`
-void footpathPrint(footpath_t *footpath, FILE *outFile);
+// prints a footpath record `*record` to file `outFile`
+void footpathRecordPrint(footpathRecord_t *record, FILE *outFile);
+
+// free allocated memory used to construct `record`
+void footpathRecordFree(footpathRecord_t *record);
 
-// free allocated memory used to construct `footpath`
-void footpathFree(footpath_t *footpath);
+// writes `record` to binary file `f` so it can be read back by footpathReadBinary
+// returns the number of bytes written
+size_t footpathWrite(footpathRecord_t *record, FILE *f);
+
+// reads a footpath written by footpathWrite from binary file `f`
+// returns the pointer, or NULL if there are no more footpaths in `f`
+footpathRecord_t* footpathReadBinary(FILE *f);
+
+// prints `footpath` to file `outFile`, reading its row from its store
+void footpathPrint(footpath_t *footpath, FILE *outFile);
 
 // replace commas inside quotations because they should be retained
 void replaceIncludedCommas(char* record);
@@ -56,6 +75,12 @@ int footpathCmpID(footpath_t* a, footpath_t* b);
 // getter that returns footpathID
 int footpathGetID(footpath_t* footpath);
 
+// getters that return the coordinates of the start and end point of `footpath`
+double footpathGetStartLon(footpath_t* footpath);
+double footpathGetStartLat(footpath_t* footpath);
+double footpathGetEndLon(footpath_t* footpath);
+double footpathGetEndLat(footpath_t* footpath);
+
 // delete any quotation marks and put back included commas
 void ensureStringFormat(char* string);
 
@@ -0,0 +1,393 @@
+/* Project: PR QuadTrees
+* delta.c :
+*            = implementation of the module delta of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "delta.h"
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+
+// creates and returns an empty delta layer
+static deltaLayer_t* deltaLayerCreate() {
+    deltaLayer_t* layer = malloc(sizeof(*layer));
+    assert(layer);
+
+    layer->store = footpathStoreCreate();
+    layer->records = arrayCreate();
+    layer->tombstones = arrayCreate();
+
+    return layer;
+}
+
+// free allocated memory used by `layer` and the footpaths it holds
+static void deltaLayerFree(deltaLayer_t* layer) {
+    arrayFreeShallow(layer->records);
+    arrayFreeShallow(layer->tombstones);
+    footpathStoreFree(layer->store);
+    free(layer);
+}
+
+// returns the number of changes held in `layer`
+static int deltaLayerSize(deltaLayer_t* layer) {
+    return layer->records->n + layer->tombstones->n;
+}
+
+// adds a tombstone for the footpath with `footpathID` to the store of `layer` and returns it
+// only the footpathID of its row is set, which is all the dedup in queries looks at
+static footpath_t* deltaTombstone(deltaLayer_t* layer, int footpathID) {
+    footpathRecord_t record = {.footpathID = footpathID, .address = "", .clueSa = "",
+                               .assetType = "", .segSide = ""};
+    return footpathStoreAdd(layer->store, &record);
+}
+
+// creates and returns a delta index over `base`, which is owned by the index from now on
+// the delta is compacted once it holds `threshold` changes, in a background thread
+// if `background` and before the change that filled it returns otherwise
+deltaIndex_t* deltaIndexCreate(qTree_t* base, int threshold, int background) {
+    deltaIndex_t* index = malloc(sizeof(*index));
+    assert(index);
+
+    index->base = base;
+    index->active = deltaLayerCreate();
+    index->compacting = NULL;
+    index->threshold = threshold;
+    index->background = background;
+    index->compactorRunning = 0;
+    if (pthread_rwlock_init(&index->lock, NULL) != 0) {
+        fprintf(stderr, "cannot create the lock of a delta index\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return index;
+}
+
+// adds `record` to the active layer, replacing any footpath with the same footpathID
+// the row of the replaced footpath stays in the store of the layer until it is freed
+// must be called holding the lock of `index` for writing
+static void deltaUpsert(deltaIndex_t* index, footpathRecord_t* record) {
+    arrayRemove(index->active->records, record->footpathID);
+    insertFootpathInArray(index->active->records, footpathStoreAdd(index->active->store, record));
+}
+
+// adds `record` to the delta, replacing any footpath with the same footpathID
+// `record` isn't kept
+void deltaInsert(deltaIndex_t* index, footpathRecord_t* record) {
+    pthread_rwlock_wrlock(&index->lock);
+    deltaUpsert(index, record);
+    int size = deltaLayerSize(index->active);
+    pthread_rwlock_unlock(&index->lock);
+
+    if (size >= index->threshold)
+        deltaIndexCompact(index);
+}
+
+// parses the rows of csv `dataFile` into the delta, replacing any footpath with the same footpathID
+// returns the number of rows ingested
+int deltaIngestFile(deltaIndex_t* index, char* dataFile) {
+    FILE *inFile = fopen(dataFile, "r");
+    assert(inFile);
+
+    footpathSkipHeaderLine(inFile);
+
+    // variables needed for getline function
+    char *linePtr = NULL;
+    size_t len = 0;
+
+    // rows are parsed before taking the lock so queries aren't held up
+    footpathRecord_t** rows = NULL;
+    int n = 0, rowsSize = 0;
+    while (getline(&linePtr, &len, inFile) != -1) {
+        if (n == rowsSize) {
+            rowsSize = rowsSize ? 2 * rowsSize : INIT_SIZE;
+            rows = realloc(rows, rowsSize * sizeof(*rows));
+            assert(rows);
+        }
+        rows[n++] = footpathRead(linePtr);
+    }
+    free(linePtr);
+    fclose(inFile);
+
+    pthread_rwlock_wrlock(&index->lock);
+    for (int i = 0; i < n; i++)
+        deltaUpsert(index, rows[i]);
+    int size = deltaLayerSize(index->active);
+    pthread_rwlock_unlock(&index->lock);
+
+    for (int i = 0; i < n; i++)
+        footpathRecordFree(rows[i]);
+    free(rows);
+
+    if (size >= index->threshold)
+        deltaIndexCompact(index);
+
+    return n;
+}
+
+// deletes the footpath with `footpathID` from the index
+void deltaDelete(deltaIndex_t* index, int footpathID) {
+    pthread_rwlock_wrlock(&index->lock);
+
+    arrayRemove(index->active->records, footpathID);
+
+    // tombstone hides the footpath in the layers below
+    if (arrayBinarySearch(index->active->tombstones, footpathID) == NULL)
+        insertFootpathInArray(index->active->tombstones, deltaTombstone(index->active, footpathID));
+
+    int size = deltaLayerSize(index->active);
+    pthread_rwlock_unlock(&index->lock);
+
+    if (size >= index->threshold)
+        deltaIndexCompact(index);
+}
+
+// starts reading `index`, footpaths found stay valid until deltaIndexEndRead
+void deltaIndexBeginRead(deltaIndex_t* index) {
+    pthread_rwlock_rdlock(&index->lock);
+}
+
+// finishes reading `index`
+void deltaIndexEndRead(deltaIndex_t* index) {
+    pthread_rwlock_unlock(&index->lock);
+}
+
+// marks every footpath changed in `layer` as visited so older layers can't return them
+static void deltaLayerVisit(deltaLayer_t* layer, array_t* footpathVisited) {
+    for (int i = 0; i < layer->records->n; i++) {
+        if (arrayBinarySearch(footpathVisited, footpathGetID(layer->records->A[i])) == NULL)
+            insertFootpathInArray(footpathVisited, layer->records->A[i]);
+    }
+    for (int i = 0; i < layer->tombstones->n; i++) {
+        if (arrayBinarySearch(footpathVisited, footpathGetID(layer->tombstones->A[i])) == NULL)
+            insertFootpathInArray(footpathVisited, layer->tombstones->A[i]);
+    }
+}
+
+// stores footpaths of `layer` with a point within `range` into `results`
+// unless already changed in a newer layer
+static void deltaLayerRange(deltaLayer_t* layer, rectangle_t* range,
+                            array_t* footpathVisited, array_t* results) {
+    for (int i = 0; i < layer->records->n; i++) {
+        footpath_t* footpath = layer->records->A[i];
+        if (arrayBinarySearch(footpathVisited, footpathGetID(footpath)) != NULL)
+            continue;
+
+        point_t start = {footpathGetStartLon(footpath), footpathGetStartLat(footpath)};
+        point_t end = {footpathGetEndLon(footpath), footpathGetEndLat(footpath)};
+        if (inRectangleStage4(range, &start) || inRectangleStage4(range, &end))
+            insertFootpathInArray(results, footpath);
+    }
+    deltaLayerVisit(layer, footpathVisited);
+}
+
+// returns whether `span` has any point in common with `range`, borders included
+static int deltaOverlaps(rectangle_t* span, rectangle_t* range) {
+    return span->topRightX >= range->botLeftX && span->botLeftX <= range->topRightX &&
+        span->topRightY >= range->botLeftY && span->botLeftY <= range->topRightY;
+}
+
+// recursively stores footpaths of the base below `node` with a point within `range`
+// into `results` unless already changed in the delta, and the quadrants visited into `trace`
+// points match as they do in the delta layers, so only nodes sharing no point with
+// `range` are skipped, where queryRange also skips some nodes only crossing it
+static void deltaBaseRange(qTreeNode_t* node, rectangle_t* range, array_t* footpathVisited,
+                            trace_t* trace, array_t* results) {
+    if (!deltaOverlaps(node->rectangle, range))
+        return;
+
+    // not an empty leaf node so append current quadrant to trace
+    if (!(node->NW == NULL && node->point == NULL))
+        traceAppend(trace, node->quadrant);
+
+    if (node->point != NULL && inRectangleStage4(range, node->point)) {
+        for (int i = 0; i < node->footpaths->n; i++) {
+            if (arrayBinarySearch(footpathVisited, footpathGetID(node->footpaths->A[i])) == NULL) {
+                insertFootpathInArray(results, node->footpaths->A[i]);
+                insertFootpathInArray(footpathVisited, node->footpaths->A[i]);
+            }
+        }
+    }
+
+    // same order of quadrants as queryRange
+    if (node->NW) {
+        deltaBaseRange(node->SW, range, footpathVisited, trace, results);
+        deltaBaseRange(node->NW, range, footpathVisited, trace, results);
+        deltaBaseRange(node->NE, range, footpathVisited, trace, results);
+        deltaBaseRange(node->SE, range, footpathVisited, trace, results);
+    }
+}
+
+// searches base and delta for points within `range`, borders included in every layer
+// stores unique, live footpaths of those points into `results` sorted by footpathID
+// and the quadrants of the base visited into `trace`
+array_t* deltaIndexRange(deltaIndex_t* index, rectangle_t* range,
+                        trace_t* trace, array_t* results) {
+    // variable to keep track of footpaths visited, seeded with every footpath
+    // changed in the delta so the base only returns footpaths still current
+    array_t* footpathVisited = arrayCreate();
+
+    // newest layer first so it wins over the layers below it
+    deltaLayerRange(index->active, range, footpathVisited, results);
+    if (index->compacting)
+        deltaLayerRange(index->compacting, range, footpathVisited, results);
+
+    deltaBaseRange(index->base->root, range, footpathVisited, trace, results);
+
+    arrayFreeShallow(footpathVisited);
+    return results;
+}
+
+// returns whether the point at `x` and `y` is the same point as `point`
+static int deltaSamePoint(double x, double y, point_t* point) {
+    point_t other = {x, y};
+    return samePoint(&other, point);
+}
+
+// stores footpaths of `layer` with a point equal to `point` into `results`
+// unless already changed in a newer layer
+static void deltaLayerSearch(deltaLayer_t* layer, point_t* point,
+                            array_t* footpathVisited, array_t* results) {
+    for (int i = 0; i < layer->records->n; i++) {
+        footpath_t* footpath = layer->records->A[i];
+        if (arrayBinarySearch(footpathVisited, footpathGetID(footpath)) != NULL)
+            continue;
+
+        if (deltaSamePoint(footpathGetStartLon(footpath), footpathGetStartLat(footpath), point) ||
+            deltaSamePoint(footpathGetEndLon(footpath), footpathGetEndLat(footpath), point))
+            insertFootpathInArray(results, footpath);
+    }
+    deltaLayerVisit(layer, footpathVisited);
+}
+
+// searches base and delta for `point`
+// stores live footpaths with a point equal to `point` into `results` sorted by footpathID
+array_t* deltaIndexSearch(deltaIndex_t* index, point_t* point, array_t* results) {
+    array_t* footpathVisited = arrayCreate();
+
+    deltaLayerSearch(index->active, point, footpathVisited, results);
+    if (index->compacting)
+        deltaLayerSearch(index->compacting, point, footpathVisited, results);
+
+    qTreeNode_t* leaf = qTreeFindLeaf(index->base, point);
+    if (leaf) {
+        for (int i = 0; i < leaf->footpaths->n; i++) {
+            footpath_t* footpath = leaf->footpaths->A[i];
+            if (arrayBinarySearch(footpathVisited, footpathGetID(footpath)) == NULL) {
+                insertFootpathInArray(results, footpath);
+                insertFootpathInArray(footpathVisited, footpath);
+            }
+        }
+    }
+
+    arrayFreeShallow(footpathVisited);
+    return results;
+}
+
+// builds a new base from the base and `compacting` layer of `index`, then swaps it in
+// runs on its own thread or the caller's, only one compactor ever runs at a time
+static void* deltaCompactor(void* arg) {
+    deltaIndex_t* index = arg;
+    qTree_t* base = index->base;
+    deltaLayer_t* delta = index->compacting;
+
+    // base and `delta` don't change while compacting so are read without the lock
+    rectangle_t* span = base->root->rectangle;
+    qTree_t* newBase = qTreeCreate(newRectangle(span->botLeftX, span->botLeftY,
+                                                span->topRightX, span->topRightY),
+                                   footpathStoreCreate());
+
+    // every footpath is stored at both of its points, so sorting makes them adjacent
+    array_t* footpaths = arrayCreate();
+    qTreeCollectFootpaths(base->root, footpaths);
+    arraySort(footpaths);
+
+    for (int i = 0; i < footpaths->n; i++) {
+        int id = footpathGetID(footpaths->A[i]);
+        if (i > 0 && footpathGetID(footpaths->A[i - 1]) == id)
+            continue;
+
+        // footpaths changed in the delta are replaced by their new version
+        if (arrayBinarySearch(delta->records, id) || arrayBinarySearch(delta->tombstones, id))
+            continue;
+
+        qTreeInsertFootpath(newBase, footpathStoreCopy(newBase->store, footpaths->A[i]));
+    }
+    for (int i = 0; i < delta->records->n; i++)
+        qTreeInsertFootpath(newBase, footpathStoreCopy(newBase->store, delta->records->A[i]));
+
+    arrayFreeShallow(footpaths);
+
+    // base is immutable from now on
+    qTreeFinalize(newBase);
+
+    pthread_rwlock_wrlock(&index->lock);
+    index->base = newBase;
+    index->compacting = NULL;
+    pthread_rwlock_unlock(&index->lock);
+
+    // no query can still be reading the old base or delta
+    qTreeFree(base);
+    deltaLayerFree(delta);
+
+    return NULL;
+}
+
+// folds the delta into a new base if not already compacting
+// in a background thread if the index was created so, on the calling thread otherwise
+void deltaIndexCompact(deltaIndex_t* index) {
+    pthread_rwlock_wrlock(&index->lock);
+
+    if (index->compacting != NULL || deltaLayerSize(index->active) == 0) {
+        pthread_rwlock_unlock(&index->lock);
+        return;
+    }
+
+    // previous compactor has already swapped in its base so finishes without the lock
+    if (index->compactorRunning)
+        pthread_join(index->compactor, NULL);
+
+    // new changes go to a fresh layer while the current one is compacted
+    index->compacting = index->active;
+    index->active = deltaLayerCreate();
+
+    index->compactorRunning = index->background &&
+        pthread_create(&index->compactor, NULL, deltaCompactor, index) == 0;
+    int started = index->compactorRunning;
+
+    pthread_rwlock_unlock(&index->lock);
+
+    // compacting on the calling thread if asked to or no thread could be started
+    if (!started)
+        deltaCompactor(index);
+}
+
+// waits for a running compaction to finish
+void deltaIndexWaitCompaction(deltaIndex_t* index) {
+    pthread_rwlock_wrlock(&index->lock);
+    int running = index->compactorRunning;
+    index->compactorRunning = 0;
+    pthread_rwlock_unlock(&index->lock);
+
+    if (running)
+        pthread_join(index->compactor, NULL);
+}
+
+// free allocated memory used by `index`, including its base
+void deltaIndexFree(deltaIndex_t* index) {
+    deltaIndexWaitCompaction(index);
+
+    qTreeFree(index->base);
+    deltaLayerFree(index->active);
+    pthread_rwlock_destroy(&index->lock);
+    free(index);
+}
@@ -0,0 +1,85 @@
+/* Project: PR QuadTrees
+* delta.h :
+*            = interface of the module delta of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _DELTA_H_
+#define _DELTA_H_
+
+#include <stdio.h>
+#include <pthread.h>
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+#include "store.h"
+
+// default number of changes held in the delta before it is folded into the base
+#define DELTA_THRESHOLD 4096
+
+// footpaths changed since the base index was built
+typedef struct deltaLayer {
+    footpathStore_t* store;  // rows of `records` and `tombstones`
+    array_t* records;  // added or updated footpaths, sorted by footpathID
+    array_t* tombstones;  // footpaths (only their footpathID) deleted from layers below
+} deltaLayer_t;
+
+// large immutable base index with a small delta of changes next to it
+typedef struct deltaIndex {
+    qTree_t* base;  // index of every footpath as of the last compaction
+    deltaLayer_t* active;  // receives new changes
+    deltaLayer_t* compacting;  // being folded into a new base, NULL if not compacting
+    int threshold;  // changes in `active` that start a compaction
+    int background;  // whether compactions run on their own thread
+    pthread_rwlock_t lock;  // held for reading by queries, for writing by changes
+    pthread_t compactor;  // background thread folding `compacting` into `base`
+    int compactorRunning;  // whether `compactor` has to be joined
+} deltaIndex_t;
+
+// creates and returns a delta index over `base`, which is owned by the index from now on
+// the delta is compacted once it holds `threshold` changes, in a background thread
+// if `background` and before the change that filled it returns otherwise
+deltaIndex_t* deltaIndexCreate(qTree_t* base, int threshold, int background);
+
+// parses the rows of csv `dataFile` into the delta, replacing any footpath with the same footpathID
+// returns the number of rows ingested
+int deltaIngestFile(deltaIndex_t* index, char* dataFile);
+
+// adds `record` to the delta, replacing any footpath with the same footpathID
+// `record` isn't kept
+void deltaInsert(deltaIndex_t* index, footpathRecord_t* record);
+
+// deletes the footpath with `footpathID` from the index
+void deltaDelete(deltaIndex_t* index, int footpathID);
+
+// starts reading `index`, footpaths found stay valid until deltaIndexEndRead
+void deltaIndexBeginRead(deltaIndex_t* index);
+
+// finishes reading `index`
+void deltaIndexEndRead(deltaIndex_t* index);
+
+// searches base and delta for points within `range`, borders included in every layer
+// stores unique, live footpaths of those points into `results` sorted by footpathID
+// and the quadrants of the base visited into `trace`
+array_t* deltaIndexRange(deltaIndex_t* index, rectangle_t* range,
+                        trace_t* trace, array_t* results);
+
+// searches base and delta for `point`
+// stores live footpaths with a point equal to `point` into `results` sorted by footpathID
+array_t* deltaIndexSearch(deltaIndex_t* index, point_t* point, array_t* results);
+
+// folds the delta into a new base if not already compacting
+// in a background thread if the index was created so, on the calling thread otherwise
+void deltaIndexCompact(deltaIndex_t* index);
+
+// waits for a running compaction to finish
+void deltaIndexWaitCompaction(deltaIndex_t* index);
+
+// free allocated memory used by `index`, including its base
+void deltaIndexFree(deltaIndex_t* index);
+
+#endif
@@ -0,0 +1,139 @@
+/* Project: PR QuadTrees
+* density.c :
+*            = implementation of the module density of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "density.h"
+#include "quadtree.h"
+#include "array.h"
+
+// state shared by every node of a density grid walk
+typedef struct densityGrid {
+    rectangle_t* rectangle;
+    int width;
+    int height;
+    long double cellWidth;
+    long double cellHeight;
+    int mode;
+    int* out;
+    array_t** cells;  // footpaths of every cell, only for DENSITY_FOOTPATHS
+} densityGrid_t;
+
+// returns the column of the grid `x` falls in, points on the right border
+// of the grid fall in the last column
+static int densityColumn(densityGrid_t* grid, long double x) {
+    int column = floorl((x - grid->rectangle->botLeftX) / grid->cellWidth);
+    if (column < 0)
+        return 0;
+    return column < grid->width ? column : grid->width - 1;
+}
+
+// returns the row of the grid `y` falls in counting up from the bottom,
+// points on the top border of the grid fall in the top row
+static int densityRow(densityGrid_t* grid, long double y) {
+    int row = floorl((y - grid->rectangle->botLeftY) / grid->cellHeight);
+    if (row < 0)
+        return 0;
+    return row < grid->height ? row : grid->height - 1;
+}
+
+// adds the `n` footpath points below `node` to the cell in `column` and `row` from the bottom
+static void densityAdd(densityGrid_t* grid, int column, int row, int n, qTreeNode_t* node) {
+    int cell = (grid->height - 1 - row) * grid->width + column;
+
+    if (grid->mode == DENSITY_POINTS)
+        grid->out[cell] += n;
+    else
+        qTreeCollectFootpaths(node, grid->cells[cell]);
+}
+
+// recursively adds the points below `node` within the grid to their cells
+static void densityNode(densityGrid_t* grid, qTreeNode_t* node) {
+    rectangle_t* span = node->rectangle;
+    rectangle_t* rectangle = grid->rectangle;
+
+    if (node->count == 0 || span->topRightX < rectangle->botLeftX || span->botLeftX > rectangle->topRightX ||
+        span->topRightY < rectangle->botLeftY || span->botLeftY > rectangle->topRightY)
+        return;
+
+    // cells are monotonic in the coordinates, so a node within the grid whose
+    // corners fall in the same cell has all its points in that cell
+    if (rectangle->botLeftX <= span->botLeftX && span->topRightX <= rectangle->topRightX &&
+        rectangle->botLeftY <= span->botLeftY && span->topRightY <= rectangle->topRightY) {
+        int column = densityColumn(grid, span->botLeftX);
+        int row = densityRow(grid, span->botLeftY);
+        if (column == densityColumn(grid, span->topRightX) && row == densityRow(grid, span->topRightY)) {
+            densityAdd(grid, column, row, node->count, node);
+            return;
+        }
+    }
+
+    if (node->point != NULL) {
+        if (inRectangleStage4(rectangle, node->point))
+            densityAdd(grid, densityColumn(grid, node->point->x), densityRow(grid, node->point->y),
+                        node->footpaths->n, node);
+        return;
+    }
+
+    if (node->NW) {
+        densityNode(grid, node->NW);
+        densityNode(grid, node->NE);
+        densityNode(grid, node->SW);
+        densityNode(grid, node->SE);
+    }
+}
+
+// counts the footpaths of `qTree` within `rectangle` split into a `width` by
+// `height` grid into `out`, row by row from the top left cell
+// subtrees within a single cell are counted whole in one walk of `qTree`
+// `mode` is DENSITY_POINTS or DENSITY_FOOTPATHS
+void qTreeDensityGrid(qTree_t* qTree, rectangle_t* rectangle, int width, int height,
+                    int mode, int* out) {
+    assert(width > 0 && height > 0);
+
+    densityGrid_t grid;
+    grid.rectangle = rectangle;
+    grid.width = width;
+    grid.height = height;
+    grid.cellWidth = (rectangle->topRightX - rectangle->botLeftX) / width;
+    grid.cellHeight = (rectangle->topRightY - rectangle->botLeftY) / height;
+    grid.mode = mode;
+    grid.out = out;
+    grid.cells = NULL;
+
+    int nCells = width * height;
+    memset(out, 0, nCells * sizeof(*out));
+
+    // a footpath is in a cell once however many of its points are,
+    // so the footpaths of every cell are gathered and counted once each
+    if (mode == DENSITY_FOOTPATHS) {
+        grid.cells = malloc(nCells * sizeof(*grid.cells));
+        assert(grid.cells);
+        for (int i = 0; i < nCells; i++)
+            grid.cells[i] = arrayCreate();
+    }
+
+    densityNode(&grid, qTree->root);
+
+    if (mode == DENSITY_FOOTPATHS) {
+        for (int i = 0; i < nCells; i++) {
+            array_t* footpaths = grid.cells[i];
+            arraySort(footpaths);
+            for (int j = 0; j < footpaths->n; j++) {
+                if (j == 0 || footpathGetID(footpaths->A[j]) != footpathGetID(footpaths->A[j - 1]))
+                    out[i]++;
+            }
+            arrayFreeShallow(footpaths);
+        }
+        free(grid.cells);
+    }
+}
@@ -0,0 +1,25 @@
+/* Project: PR QuadTrees
+* density.h :
+*            = interface of the module density of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _DENSITY_H_
+#define _DENSITY_H_
+
+#include "quadtree.h"
+
+// what the cells of a density grid count
+#define DENSITY_POINTS 0  // footpath points, a footpath counts once per point in the cell
+#define DENSITY_FOOTPATHS 1  // distinct footpaths with a point in the cell
+
+// counts the footpaths of `qTree` within `rectangle` split into a `width` by
+// `height` grid into `out`, row by row from the top left cell
+// subtrees within a single cell are counted whole in one walk of `qTree`
+// `mode` is DENSITY_POINTS or DENSITY_FOOTPATHS
+void qTreeDensityGrid(qTree_t* qTree, rectangle_t* rectangle, int width, int height,
+                    int mode, int* out);
+
+#endif
@@ -0,0 +1,113 @@
+/* Project: PR QuadTrees
+* dictionary.c :
+*            = implementation of the module dictionary of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "dictionary.h"
+
+// returns the djb2 hash of `string`
+static unsigned int dictionaryHash(char* string) {
+    unsigned int hash = 5381;
+    for (; *string; string++)
+        hash = hash * 33 + (unsigned char)*string;
+    return hash;
+}
+
+// returns the slot of the table of `dictionary` holding `string` or
+// the empty slot it would go in
+static int dictionarySlot(dictionary_t* dictionary, char* string) {
+    int mask = dictionary->tableSize - 1;
+    int slot = dictionaryHash(string) & mask;
+
+    while (dictionary->table[slot] != -1 &&
+            strcmp(dictionary->strings[dictionary->table[slot]], string) != 0)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+// creates and returns an empty dictionary
+dictionary_t* dictionaryCreate() {
+    dictionary_t* dictionary = malloc(sizeof(*dictionary));
+    assert(dictionary);
+
+    dictionary->n = 0;
+    dictionary->size = DICTIONARY_INIT_SIZE;
+    dictionary->strings = malloc(dictionary->size * sizeof(*dictionary->strings));
+    dictionary->tableSize = 2 * DICTIONARY_INIT_SIZE;
+    dictionary->table = malloc(dictionary->tableSize * sizeof(*dictionary->table));
+    assert(dictionary->strings && dictionary->table);
+    memset(dictionary->table, -1, dictionary->tableSize * sizeof(*dictionary->table));
+
+    return dictionary;
+}
+
+// doubles the strings `dictionary` can hold and rehashes them
+static void dictionaryGrow(dictionary_t* dictionary) {
+    dictionary->size *= 2;
+    dictionary->strings = realloc(dictionary->strings, dictionary->size * sizeof(*dictionary->strings));
+    assert(dictionary->strings);
+
+    free(dictionary->table);
+    dictionary->tableSize = 2 * dictionary->size;
+    dictionary->table = malloc(dictionary->tableSize * sizeof(*dictionary->table));
+    assert(dictionary->table);
+    memset(dictionary->table, -1, dictionary->tableSize * sizeof(*dictionary->table));
+
+    for (int code = 0; code < dictionary->n; code++)
+        dictionary->table[dictionarySlot(dictionary, dictionary->strings[code])] = code;
+}
+
+// returns the code of `string` in `dictionary`, adding a copy of `string` if not there
+int dictionaryEncode(dictionary_t* dictionary, char* string) {
+    int slot = dictionarySlot(dictionary, string);
+    if (dictionary->table[slot] != -1)
+        return dictionary->table[slot];
+
+    if (dictionary->n == dictionary->size) {
+        dictionaryGrow(dictionary);
+        slot = dictionarySlot(dictionary, string);
+    }
+
+    int code = dictionary->n++;
+    dictionary->strings[code] = strdup(string);
+    assert(dictionary->strings[code]);
+    dictionary->table[slot] = code;
+    return code;
+}
+
+// returns the code of `string` in `dictionary`, -1 if not there
+int dictionaryLookup(dictionary_t* dictionary, char* string) {
+    return dictionary->table[dictionarySlot(dictionary, string)];
+}
+
+// returns the string of `code` in `dictionary`
+char* dictionaryDecode(dictionary_t* dictionary, int code) {
+    assert(code >= 0 && code < dictionary->n);
+    return dictionary->strings[code];
+}
+
+// returns the bytes of memory used by `dictionary`
+size_t dictionaryMemoryUsage(dictionary_t* dictionary) {
+    size_t bytes = sizeof(*dictionary) + dictionary->size * sizeof(*dictionary->strings) +
+                dictionary->tableSize * sizeof(*dictionary->table);
+    for (int code = 0; code < dictionary->n; code++)
+        bytes += strlen(dictionary->strings[code]) + 1;
+    return bytes;
+}
+
+// free allocated memory used by `dictionary`
+void dictionaryFree(dictionary_t* dictionary) {
+    for (int code = 0; code < dictionary->n; code++)
+        free(dictionary->strings[code]);
+    free(dictionary->strings);
+    free(dictionary->table);
+    free(dictionary);
+}
@@ -0,0 +1,41 @@
+/* Project: PR QuadTrees
+* dictionary.h :
+*            = interface of the module dictionary of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _DICTIONARY_H_
+#define _DICTIONARY_H_
+
+#define DICTIONARY_INIT_SIZE 16  // initial number of strings a dictionary can hold
+
+// distinct strings of a field numbered 0,1,2.. in the order they were first seen
+typedef struct dictionary {
+    char** strings;  // string of every code
+    int n;  // strings in the dictionary
+    int size;  // strings the dictionary can hold before growing
+    int* table;  // open addressing table of codes by hash of their string, -1 for an empty slot
+    int tableSize;  // power of 2, at least twice `size`
+} dictionary_t;
+
+// creates and returns an empty dictionary
+dictionary_t* dictionaryCreate();
+
+// returns the code of `string` in `dictionary`, adding a copy of `string` if not there
+int dictionaryEncode(dictionary_t* dictionary, char* string);
+
+// returns the code of `string` in `dictionary`, -1 if not there
+int dictionaryLookup(dictionary_t* dictionary, char* string);
+
+// returns the string of `code` in `dictionary`
+char* dictionaryDecode(dictionary_t* dictionary, int code);
+
+// returns the bytes of memory used by `dictionary`
+size_t dictionaryMemoryUsage(dictionary_t* dictionary);
+
+// free allocated memory used by `dictionary`
+void dictionaryFree(dictionary_t* dictionary);
+
+#endif
@@ -10,6 +10,10 @@
 * and make a quadtree using the starting and ending latitudes and 
 * longtitudes of the footpaths, adding querying functionality
 *
+* The span of the quadtree is given by four co-ordinates on the command
+* line, or fitted to the data when they are all "auto", and the quadtree
+* grows to take in any footpath outside of it
+*
 * Stage 3: 
 * Accept co-ordinate pairs from stdin, search the constructed quadtree
 * for the point region containing the co-ordinate pair and print all 
@@ -21,25 +25,187 @@
 * and efficiently use the quadtree to find all footpaths which are
 * within the bounds of the query
 *
+* Stage 5:
+* same queries as stage 4 answered from tiles of the data file stored on
+* disk, which are paged in on demand within a memory budget so the data
+* file doesn't need to fit in memory
+*
+* Stage 6:
+* report the bytes of memory used by every structure of the quadtree
+* as built, finalized and frozen
+*
+* Stage 7:
+* same queries as stage 4 answered by the query planner, which prints
+* the plan it chose instead of the quadrants visited
+*
+* Stage 8:
+* report every pair of footpath points at most a distance in metres apart
+* given as an extra argument, walking the quadtree against itself
+*
+* Stage 9:
+* accept a rectangle and a grid width and height from stdin and print the
+* number of footpath points (extra argument 0) or footpaths (extra argument 1)
+* in every cell of the grid
+*
+* Stage 10:
+* accept the same queries as stage 4 from stdin and print the time taken to
+* answer all of them, and to search for the start and end point of every
+* footpath, which only walks down the tree, before and after the quadtree is
+* frozen and once the frozen block is moved, with the memory pages the nodes
+* are spread over. Cache and TLB misses are counted by running it under perf:
+*   perf stat -e cycles,instructions,cache-misses,dTLB-load-misses \
+*       ./dict 10 data.csv out.txt 144.9 -37.9 145.1 -37.7 < queries.txt
+* perf counts the whole run, building the quadtree and every layout included
+*
+* Stage 11:
+* same queries and output as stage 4, all answered together in one walk
+* of the quadtree once stdin is read
+*
+* Stage 12:
+* same queries as stage 4 keeping only footpaths meeting the attribute
+* conditions given as extra arguments, e.g. asset_type=Laneway|Road Footway
+* or grade1in=10:30, prints the cost of every query instead of the quadrants
+*
+* Stage 13:
+* same queries as stage 4 at the level of detail given as an extra argument,
+* parts of the quadtree no larger than it are printed as one footpath
+* standing in for the number of footpath points printed before it
+*
+* Stage 14:
+* same queries as stage 4 answered in pages, each page stopping once it has
+* visited the number of nodes, found the number of footpaths or taken the
+* microseconds given as extra arguments (0 for no limit), and the next page
+* resuming where the last one stopped
+*
+* Stage 15:
+* same queries and output as stage 4 on a quadtree built by the number of
+* threads given as an extra argument all inserting at once
+*
+* Stage 16:
+* same queries and output as stage 3 answered by the compressed quadtree,
+* in which chains of nodes with a single non empty quadrant are one node
+*
+* Stage 17:
+* same queries and output as stage 3 answered by the quadtree generic over
+* its payload, specialized for footpaths
+*
+* Stage 18:
+* same queries and output as stages 3 and 4, read from the binary query file
+* written by queryconvert given as an extra argument instead of stdin
+* "knn x y k" and "radius x y metres" print the footpaths nearest to x y,
+* nearest first, or within the radius of it, and how many were found
+*
+* Stage 19:
+* same queries as stage 4 keeping only the footpaths with the largest value
+* of the numeric attribute given as an extra argument, e.g. distance, as many
+* as the next extra argument, or the smallest if the last one is "smallest"
+*
+* Stage 20:
+* build the graph of footpaths meeting at a point, or with points at most the
+* metres given as an extra argument apart, print its size and connected
+* components, then accept pairs of footpath ids from stdin and print the
+* shortest walk between them by distance
+*
+* Stage 21:
+* report the shape of the quadtree as JSON: nodes by type and depth, leaves
+* by number of footpaths, empty children of splits, the deepest leaves and
+* the bytes of memory used by every structure
+*
+* Stage 22:
+* treat the query ranges as successive positions of a panned map viewport and
+* find only the footpaths that came into view and the ones that went out of it
+*
+* Stage 23:
+* same queries as stage 3 with an elevation after the point, answered by the
+* octree of the footpaths with elevation as the third axis, printing octants
+*
+* Stage 24:
+* boxes with an elevation after each corner queried in the octree of stage 23,
+* the elevation bounds pruning subtrees as the plane bounds do
+*
+* Stage 25:
+* same queries and output format as stage 4 after the footpaths of a second
+* data file are added to the quadtree and the footpaths listed in a file
+* deleted, both held in a delta next to the quadtree rather than rebuilding it,
+* footpaths of every query sorted by footpathID. Every layer finds a footpath
+* with a point within the range borders included, so quadtrees are only pruned
+* where they share no point with the range, which finds footpaths stage 4 can
+* miss. The delta is folded in before the change filling it returns, so output
+* doesn't depend on timing
+*
 * ----------------------------------------------------------------*/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "data.h"
 #include "quadtree.h"
 #include "array.h"
-#include "linkedlist.h"
+#include "trace.h"
+#include "tile.h"
+#include "loader.h"
+#include "planner.h"
+#include "exactindex.h"
+#include "join.h"
+#include "density.h"
+#include "batch.h"
+#include "filter.h"
+#include "store.h"
+#include "lod.h"
+#include "budget.h"
+#include "concurrent.h"
+#include "compressed.h"
+#include "footpathtree.h"
+#include "queryfile.h"
+#include "topk.h"
+#include "graph.h"
+#include "analyze.h"
+#include "viewport.h"
+#include "delta.h"
 
 #define NOTFOUND "NOTFOUND"
+#define AUTO_BOUNDS "auto"
 #define EXACT_QUERY 3
 #define RANGE_QUERY 4
+#define TILED_RANGE_QUERY 5
+#define MEMORY_REPORT 6
+#define PLANNED_RANGE_QUERY 7
+#define PROXIMITY_JOIN 8
+#define DENSITY_GRID 9
+#define FREEZE_BENCHMARK 10
+#define BATCHED_RANGE_QUERY 11
+#define FILTERED_RANGE_QUERY 12
+#define LOD_RANGE_QUERY 13
+#define BUDGETED_RANGE_QUERY 14
+#define CONCURRENT_RANGE_QUERY 15
+#define COMPRESSED_EXACT_QUERY 16
+#define GENERIC_EXACT_QUERY 17
+#define BINARY_QUERY 18
+#define TOPK_RANGE_QUERY 19
+#define FOOTPATH_GRAPH 20
+#define TREE_ANALYSIS 21
+#define VIEWPORT_DELTA_QUERY 22
+#define OCTREE_EXACT_QUERY 23
+#define OCTREE_BOX_QUERY 24
+#define DELTA_RANGE_QUERY 25
+
+// returns the span of the quadtree from command line arguments, or the
+// tightest span holding `footpaths` if `botLeftX` is AUTO_BOUNDS
+rectangle_t* getRootRectangle(array_t* footpaths, char* botLeftX, char* botLeftY,
+                            char* topRightX, char* topRightY);
 
 // makes a quadtree from input file and quadtree span from command line arguments
 qTree_t* getQuadTree(char* fileName, char* botLeftX, char* botLeftY, char* topRightX, char* topRightY);
 
+// makes an octree from input file, its span in the plane from command line arguments
+// and its span in elevation from the footpaths, which are added to `store`
+footpathOctree_t* getOctree(char* fileName, char* botLeftX, char* botLeftY, char* topRightX,
+                            char* topRightY, footpathStore_t* store);
+
 // function to query qtree for point region matches through `inFile`
 // prints to `outFile` and `infoFile`
 void qTreeExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX, char* topRightY,
@@ -50,6 +216,131 @@ void qTreeExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* to
 void qTreeRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX, char* topRightY,
                         FILE *inFile, FILE *outFile, FILE *infoFile);
 
+// answers the range queries through `inFile` on `qTree` once it is built
+// prints to `outFile` and `infoFile`
+static void answerRangeQueries(qTree_t* qTree, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query tiles of the data file for region matches through `inFile`
+// tiles are written to `tileDir` split `tileLevel` times unless already built from it,
+// and at most `budget` bytes of tiles are kept in memory between queries
+// prints to `outFile` and `infoFile`
+void qTreeTiledRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* tileDir, char* tileLevel, char* budget,
+                 FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// prints the footpaths in `results` of the range query with corners `botLeftX`,
+// `botLeftY`, `topRightX` and `topRightY` to `infoFile` and `trace` to `outFile`
+void printRangeQuery(FILE *outFile, FILE *infoFile, char* botLeftX, char* botLeftY,
+                    char* topRightX, char* topRightY, trace_t* trace, array_t* results);
+
+// function to report the memory used by the qtree of the data file
+// before and after it is finalized and frozen, prints to `outFile`
+void qTreeMemoryReport(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                        char* topRightY, FILE *outFile);
+
+// function to query qtree for region matches through `inFile` using the query planner
+// prints footpaths to `infoFile` and the plan chosen for every query to `outFile`
+void qTreePlannedRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to report every pair of points of the qtree at most `distance` metres apart
+// prints the pairs to `outFile` and the footpaths of both points of every pair to `infoFile`
+void qTreeProximityJoin(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* distance, FILE *outFile, FILE *infoFile);
+
+// function to print density grids of the qtree through `inFile`, counting footpath
+// points or footpaths by `mode`, prints to `outFile`
+void qTreeDensityQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* mode, FILE *inFile, FILE *outFile);
+
+// function to time searches for the start and end point of every footpath and
+// the range queries through `inFile` on the qtree before and after it is frozen,
+// prints to `outFile`
+void qTreeFreezeBenchmark(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile);
+
+// function to query qtree for region matches through `inFile` as qTreeRangeQuerying does,
+// answering all queries in one walk of the qtree, prints to `outFile` and `infoFile`
+void qTreeBatchedRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for region matches through `inFile` keeping only footpaths
+// meeting `predicate`, prints footpaths to `infoFile` and the cost of every query to `outFile`
+void qTreeFilteredRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, predicate_t* predicate, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for region matches through `inFile` at level of detail `resolution`
+// prints items to `infoFile` and the number of items and footpath points to `outFile`
+void qTreeLodRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* resolution, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for region matches through `inFile` in pages limited by `budget`
+// prints footpaths of every page to `infoFile` and whether it was cut short to `outFile`
+void qTreeBudgetedRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, queryBudget_t* budget, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for region matches through `inFile` as qTreeRangeQuerying does,
+// with the qtree built by `threads` threads inserting at once, prints to `outFile` and `infoFile`
+void qTreeConcurrentRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* threads, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for point region matches through `inFile` as qTreeExactQuerying
+// does, searching the compressed quadtree instead, prints to `outFile` and `infoFile`
+void qTreeCompressedExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query the footpath specialization of the generic quadtree for point region
+// matches through `inFile` as qTreeExactQuerying does, prints to `outFile` and `infoFile`
+void qTreeGenericExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for the point region and region matches in binary query file
+// `queryFileName` as qTreeExactQuerying and qTreeRangeQuerying do, prints to `outFile` and `infoFile`
+void qTreeBinaryQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, char* queryFileName, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for the `k` footpaths within regions through `inFile` with the
+// largest or smallest, by `order`, numeric `attribute`, prints footpaths best first
+// to `infoFile` and the cost of every query to `outFile`
+void qTreeTopKRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, int attribute, int k, int order, FILE *inFile, FILE *outFile,
+                 FILE *infoFile);
+
+// function to build the footpath graph of the qtree, joining points at most `tolerance`
+// metres apart, and find the shortest walks between pairs of footpaths through `inFile`
+// prints the size of the graph and the length of every walk to `outFile` and
+// the footpaths of every walk to `infoFile`
+void qTreeFootpathGraph(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* tolerance, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to report the shape of the qtree of the data file as it is queried,
+// prints JSON to `outFile`
+void qTreeAnalysis(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *outFile);
+
+// function to follow a viewport moved to every range in `inFile` in turn
+// prints the number of footpaths that came into and went out of view to `outFile`
+// and the footpaths that came into view and IDs of those that went out to `infoFile`
+void qTreeViewportQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query the octree for points in space through `inFile` as qTreeExactQuerying
+// does, prints octants visited to `outFile` and footpaths found to `infoFile`
+void octreeExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query the octree for footpaths with a point within boxes through `inFile`
+// prints the number of footpaths found to `outFile` and the footpaths to `infoFile`
+void octreeBoxQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile);
+
+// function to query qtree for region matches through `inFile` after adding the footpaths
+// of csv `addedFile` and deleting the footpathIDs in `deletedFile`, one per line, through
+// a delta folded into the qtree once it holds `threshold` changes, prints as stage 4 does
+void qTreeDeltaRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* addedFile, char* deletedFile, int threshold,
+                 FILE *inFile, FILE *outFile, FILE *infoFile);
+
 int main(int argc, char *argv[]) {
     FILE *infoFile = fopen(argv[3], "w");
 	assert(infoFile);
@@ -60,60 +351,156 @@ int main(int argc, char *argv[]) {
             qTreeExactQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout, infoFile);
         case RANGE_QUERY:
             qTreeRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout, infoFile);
+            break;
+        case TILED_RANGE_QUERY:
+            // extra arguments are the tile directory, tile level and memory budget in bytes
+            assert(argc > 10);
+            qTreeTiledRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7],
+                                    argv[8], argv[9], argv[10], stdin, stdout, infoFile);
+            break;
+        case MEMORY_REPORT:
+            qTreeMemoryReport(argv[2], argv[4], argv[5], argv[6], argv[7], stdout);
+            break;
+        case PLANNED_RANGE_QUERY:
+            qTreePlannedRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout, infoFile);
+            break;
+        case PROXIMITY_JOIN:
+            // extra argument is the distance in metres
+            assert(argc > 8);
+            qTreeProximityJoin(argv[2], argv[4], argv[5], argv[6], argv[7], argv[8], stdout, infoFile);
+            break;
+        case DENSITY_GRID:
+            // extra argument is the density mode
+            assert(argc > 8);
+            qTreeDensityQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], argv[8], stdin, stdout);
+            break;
+        case FREEZE_BENCHMARK:
+            qTreeFreezeBenchmark(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout);
+            break;
+        case BATCHED_RANGE_QUERY:
+            qTreeBatchedRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout, infoFile);
+            break;
+        case FILTERED_RANGE_QUERY: {
+            // extra arguments are the conditions footpaths have to meet
+            predicate_t* predicate = predicateCreate();
+            for (int i = 8; i < argc; i++) {
+                if (!predicateParse(predicate, argv[i])) {
+                    fprintf(stderr, "invalid condition %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+            }
+            qTreeFilteredRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], predicate,
+                                    stdin, stdout, infoFile);
+            predicateFree(predicate);
+            break;
+        }
+        case LOD_RANGE_QUERY:
+            // extra argument is the level of detail, in the units of the co-ordinates
+            assert(argc > 8);
+            qTreeLodRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], argv[8],
+                                stdin, stdout, infoFile);
+            break;
+        case BUDGETED_RANGE_QUERY: {
+            // extra arguments are the most nodes, footpaths and microseconds of a page
+            assert(argc > 10);
+            queryBudget_t budget = {atoi(argv[8]), atoi(argv[9]), atol(argv[10])};
+            qTreeBudgetedRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], &budget,
+                                    stdin, stdout, infoFile);
+            break;
+        }
+        case CONCURRENT_RANGE_QUERY:
+            // extra argument is the number of threads building the quadtree
+            assert(argc > 8);
+            qTreeConcurrentRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], argv[8],
+                                        stdin, stdout, infoFile);
+            break;
+        case COMPRESSED_EXACT_QUERY:
+            qTreeCompressedExactQuerying(argv[2], argv[4], argv[5], argv[6], argv[7],
+                                        stdin, stdout, infoFile);
+            break;
+        case GENERIC_EXACT_QUERY:
+            qTreeGenericExactQuerying(argv[2], argv[4], argv[5], argv[6], argv[7],
+                                    stdin, stdout, infoFile);
+            break;
+        case BINARY_QUERY:
+            // extra argument is the binary query file
+            assert(argc > 8);
+            qTreeBinaryQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], argv[8],
+                                stdout, infoFile);
+            break;
+        case TOPK_RANGE_QUERY: {
+            // extra arguments are the attribute, how many footpaths and which end to keep
+            assert(argc > 9);
+            int attribute = numericAttributeLookup(argv[8]);
+            if (attribute == -1) {
+                fprintf(stderr, "invalid attribute %s\n", argv[8]);
+                exit(EXIT_FAILURE);
+            }
+            int order = argc > 10 && strcmp(argv[10], "smallest") == 0 ? TOPK_SMALLEST : TOPK_LARGEST;
+            qTreeTopKRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], attribute,
+                                atoi(argv[9]), order, stdin, stdout, infoFile);
+            break;
+        }
+        case FOOTPATH_GRAPH:
+            // extra argument is the distance in metres points are joined within
+            assert(argc > 8);
+            qTreeFootpathGraph(argv[2], argv[4], argv[5], argv[6], argv[7], argv[8],
+                                stdin, stdout, infoFile);
+            break;
+        case TREE_ANALYSIS:
+            qTreeAnalysis(argv[2], argv[4], argv[5], argv[6], argv[7], stdout);
+            break;
+        case VIEWPORT_DELTA_QUERY:
+            qTreeViewportQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout, infoFile);
+            break;
+        case OCTREE_EXACT_QUERY:
+            octreeExactQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout, infoFile);
+            break;
+        case OCTREE_BOX_QUERY:
+            octreeBoxQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], stdin, stdout, infoFile);
+            break;
+        case DELTA_RANGE_QUERY:
+            // extra arguments are the added data file, the deleted footpathIDs file
+            // and optionally the changes that start folding the delta into the qtree
+            assert(argc > 9);
+            qTreeDeltaRangeQuerying(argv[2], argv[4], argv[5], argv[6], argv[7], argv[8], argv[9],
+                                    argc > 10 ? atoi(argv[10]) : DELTA_THRESHOLD,
+                                    stdin, stdout, infoFile);
+            break;
     }
 
     fclose(infoFile);
     return 0;
 }
 
-// makes a quadtree from input file and quadtree span from command line arguments
-qTree_t* getQuadTree(char* fileName, char* botLeftX, char* botLeftY, char* topRightX, char* topRightY) {
-    FILE *inFile = fopen(fileName, "r");
-    assert(inFile);
-
-    // constructing rectangle spanned by the tree
-    rectangle_t* rootRectangle = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
-                                            strtold(topRightX, NULL), strtold(topRightY, NULL));
-
-                                    
-    qTree_t* qTree = qTreeCreate(rootRectangle);
-
-    footpathSkipHeaderLine(inFile);
-
-    // variables needed for getline function
-    char *linePtr = NULL;
-    size_t len = 0;
-
-    footpath_t *footpath;
-    
-    // variable to duplicate `footpath` to avoid freeing memory twice
-    footpath_t *dupFootpath;  
-    
-
-    while (getline(&linePtr, &len, inFile) != -1) {
-        footpath = footpathRead(linePtr);
-        dupFootpath = malloc(sizeof(*dupFootpath));
-        assert(dupFootpath);
+// returns the span of the quadtree from command line arguments, or the
+// tightest span holding `footpaths` if `botLeftX` is AUTO_BOUNDS
+rectangle_t* getRootRectangle(array_t* footpaths, char* botLeftX, char* botLeftY,
+                            char* topRightX, char* topRightY) {
+    if (strcmp(botLeftX, AUTO_BOUNDS) == 0)
+        return qTreeBounds(footpaths);
 
-        // duplicating `footpath` to `dupFootpath`
-        memcpy (dupFootpath, footpath, sizeof(*dupFootpath));
+    return newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                        strtold(topRightX, NULL), strtold(topRightY, NULL));
+}
 
-        // ensuring a deep copy of `footpath`
-        dupFootpath->address = strdup(footpath->address);
-        dupFootpath->clueSa = strdup(footpath->clueSa);
-        dupFootpath->assetType = strdup(footpath->assetType);
-        dupFootpath->segSide = strdup(footpath->segSide);
-        
+// makes a quadtree from input file and quadtree span from command line arguments
+qTree_t* getQuadTree(char* fileName, char* botLeftX, char* botLeftY, char* topRightX, char* topRightY) {
+    // rows are parsed in parallel but inserted in their order in the file
+    // so the tree and the output don't depend on the number of threads
+    footpathStore_t* store = footpathStoreCreate();
+    array_t* footpaths = footpathLoad(fileName, loaderThreads(), store);
 
-        point_t* startPoint = newPoint(footpath->startLon, footpath->startLat);
-        point_t* endPoint = newPoint(dupFootpath->endLon, dupFootpath->endLat);
+    qTree_t* qTree = qTreeCreate(getRootRectangle(footpaths, botLeftX, botLeftY, topRightX, topRightY),
+                                 store);
 
-        qTreeInsert(qTree, startPoint, footpath);
-        qTreeInsert(qTree, endPoint, dupFootpath);
+    for (int i = 0; i < footpaths->n; i++) {
+        // inserts both the start and end point of the footpath
+        qTreeInsertFootpath(qTree, footpaths->A[i]);
     }
 
-    free(linePtr);
-	fclose(inFile);
+    // footpaths are owned by `store`, which is now owned by `qTree`
+    arrayFreeShallow(footpaths);
 
 	return qTree;
 }
@@ -125,33 +512,42 @@ void qTreeExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* to
 
     qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
 
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+    qTreeFreeze(qTree);
+
+    // exact queries hash straight to the leaf of the point
+    exactIndexBuild(qTree);
+
     // variables needed for getline function
     char* linePtr = NULL;
     size_t len = 0;
 
+    // variable to store which quadrants of tree visited to reach match, reused by every query
+    trace_t* trace = traceCreate();
+
     while (getline(&linePtr, &len, inFile) != -1) {
         // formatting input read from a line
         char* x = strtok(linePtr, " ");
         char* y = strtok(NULL, "\n");
 
-        // variable to store which quadrants of tree visited to reach match
-        list_t* quadrants = listCreate();
+        traceReset(trace);
 
         point_t* query = newPoint(atof(x), atof(y));
 
-        // searching `qTree` for `query`, updating `quadrants` to keep track of quadrants visited
-        qTreeSearch(qTree, query, quadrants, infoFile, x, y);
+        // searching `qTree` for `query`, updating `trace` to keep track of quadrants visited
+        qTreeSearch(qTree, query, trace, infoFile, x, y);
 
-        if (quadrants->n == 0) {
+        if (trace->n == 0) {
             fprintf(outFile, "%s %s --> %s\n", x, y, NOTFOUND);
         } else {
             fprintf(outFile, "%s %s --> ", x, y);
-            listPrint(quadrants, outFile);
+            tracePrint(trace, outFile);
         }
         free(query);
-        listFree(quadrants);
     }
     free(linePtr);
+    traceFree(trace);
     qTreeFree(qTree);
 }
 
@@ -161,11 +557,24 @@ void qTreeRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* to
                  char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
                      
     qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+    answerRangeQueries(qTree, inFile, outFile, infoFile);
+    qTreeFree(qTree);
+}
+
+// answers the range queries through `inFile` on `qTree` once it is built
+// prints to `outFile` and `infoFile`
+static void answerRangeQueries(qTree_t* qTree, FILE *inFile, FILE *outFile, FILE *infoFile) {
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+    qTreeFreeze(qTree);
 
     // variables needed for getline function
     char* linePtr = NULL;
     size_t len = 0;
 
+    // variable to store which quadrants visited to reach matches, reused by every query
+    trace_t* trace = traceCreate();
+
     while (getline(&linePtr, &len, inFile) != -1) {
         // formatting input read from a line
         char* botLeftX = strtok(linePtr, " ");
@@ -173,8 +582,7 @@ void qTreeRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* to
         char* topRightX = strtok(NULL, " ");
         char* topRightY = strtok(NULL, "\n");
 
-        // variable to store which quadrants of tree visited to reach match
-        list_t* quadrants = listCreate();
+        traceReset(trace);
 
         // query range we use to search points within
         rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
@@ -186,40 +594,1230 @@ void qTreeRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* to
         array_t* results = arrayCreate();
 
         // searches quad tree for points within range
-        queryRange(qTree->root, range, footpathVisited, quadrants, results);  
+        qTreeRange(qTree, range, footpathVisited, trace, results);
+
+        printRangeQuery(outFile, infoFile, botLeftX, botLeftY, topRightX, topRightY,
+                        trace, results);
+
+        free(range);
+
+        // footpaths in `footpathVisited` and `results` are freed with `qTree`
+        arrayFreeShallow(footpathVisited);
+        arrayFreeShallow(results);
+    }
+    free(linePtr);
+    traceFree(trace);
+}
+
+// function to query tiles of the data file for region matches through `inFile`
+// tiles are written to `tileDir` split `tileLevel` times unless already built from it,
+// and at most `budget` bytes of tiles are kept in memory between queries
+// prints to `outFile` and `infoFile`
+void qTreeTiledRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* tileDir, char* tileLevel, char* budget,
+                 FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    // constructing rectangle spanned by the tiles
+    rectangle_t* rootRectangle = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                                        strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+    // tiles are built again unless they were built from this data file, span and level
+    tileIndex_t* index = tileIndexOpen(tileDir, dataFile, rootRectangle, atoi(tileLevel),
+                                        strtoull(budget, NULL, 10));
+    if (index == NULL) {
+        tileIndexBuild(dataFile, tileDir, rootRectangle, atoi(tileLevel));
+        index = tileIndexOpen(tileDir, dataFile, rootRectangle, atoi(tileLevel),
+                                strtoull(budget, NULL, 10));
+        assert(index);
+    }
+    free(rootRectangle);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // variable to store which quadrants visited to reach matches, reused by every query
+    trace_t* trace = traceCreate();
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        traceReset(trace);
+
+        // query range we use to search points within
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        // variable to keep track of footpaths visited to avoid printing duplicate footpaths
+        array_t* footpathVisited = arrayCreate();
+
+        array_t* results = arrayCreate();
+
+        // searches tiles for points within range
+        tileIndexRange(index, range, footpathVisited, trace, results);
+
+        printRangeQuery(outFile, infoFile, botLeftX, botLeftY, topRightX, topRightY,
+                        trace, results);
+
+        free(range);
+
+        // footpaths in `footpathVisited` and `results` are freed with the tiles
+        arrayFreeShallow(footpathVisited);
+        arrayFreeShallow(results);
+    }
+    free(linePtr);
+    traceFree(trace);
+    tileIndexFree(index);
+}
+
+// prints the footpaths in `results` of the range query with corners `botLeftX`,
+// `botLeftY`, `topRightX` and `topRightY` to `infoFile` and `trace` to `outFile`
+void printRangeQuery(FILE *outFile, FILE *infoFile, char* botLeftX, char* botLeftY,
+                    char* topRightX, char* topRightY, trace_t* trace, array_t* results) {
+
+    fprintf(infoFile, "%s %s %s %s\n", botLeftX, botLeftY, topRightX, topRightY);
+    for (int i = 0; i < results->n; i++)
+        footpathPrint(results->A[i], infoFile);
+
+    if (trace->n == 0) {
+        fprintf(outFile, "%s %s %s %s --> %s\n", botLeftX, botLeftY,
+                topRightX, topRightY, NOTFOUND);
+    } else {
+        fprintf(outFile, "%s %s %s %s -->", botLeftX, botLeftY,
+                 topRightX, topRightY);
+
+        tracePrint(trace, outFile);
+    }
+}
+
+// function to report the memory used by the qtree of the data file
+// before and after it is finalized and frozen, prints to `outFile`
+void qTreeMemoryReport(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                        char* topRightY, FILE *outFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+    qTreeMemory_t memory;
+
+    qTreeMemoryUsage(qTree, &memory);
+    fprintf(outFile, "built\n");
+    qTreeMemoryPrint(&memory, outFile);
+
+    qTreeFinalize(qTree);
+
+    qTreeMemoryUsage(qTree, &memory);
+    fprintf(outFile, "finalized\n");
+    qTreeMemoryPrint(&memory, outFile);
+
+    qTreeFreeze(qTree);
+
+    qTreeMemoryUsage(qTree, &memory);
+    fprintf(outFile, "frozen\n");
+    qTreeMemoryPrint(&memory, outFile);
+
+    // chains of nodes with a single non empty quadrant collapsed into one node
+    compressedTree_t* compressed = compressedTreeBuild(qTree);
+    fprintf(outFile, "compressed\n");
+    fprintf(outFile, "nodes: %zu\n", compressedTreeNodeBytes(compressed));
+    fprintf(outFile, "prefixes: %zu\n", compressedTreePrefixBytes(compressed));
+    fprintf(outFile, "node count: %d (quadtree %d)\n", compressed->n, qTree->nFrozenNodes);
+    fprintf(outFile, "depth: %d (quadtree %d)\n", compressed->depth, compressed->quadtreeDepth);
+    compressedTreeFree(compressed);
+
+    qTreeFree(qTree);
+}
+
+// function to query qtree for region matches through `inFile` using the query planner
+// prints footpaths to `infoFile` and the plan chosen for every query to `outFile`
+void qTreePlannedRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    // queries covering most of the tree scan a flat array of its points
+    plannerBuild(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        // query range we use to search points within
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        array_t* results = arrayCreate();
+        queryStats_t stats;
+
+        // searches quad tree for points within range with the plan estimated to be fastest
+        qTreePlannedRange(qTree, range, SCAN_THRESHOLD, &stats, results);
 
         fprintf(infoFile, "%s %s %s %s\n", botLeftX, botLeftY, topRightX, topRightY);
         for (int i = 0; i < results->n; i++)
             footpathPrint(results->A[i], infoFile);
 
-        if (quadrants->n == 0) {
-            fprintf(outFile, "%s %s %s %s --> %s\n", botLeftX, botLeftY,
-                    topRightX, topRightY, NOTFOUND);
-        } else {
-            fprintf(outFile, "%s %s %s %s -->", botLeftX, botLeftY,
-                     topRightX, topRightY);
-                     
-            listPrint(quadrants, outFile);
-        }
-        listFree(quadrants);
+        fprintf(outFile, "%s %s %s %s --> ", botLeftX, botLeftY, topRightX, topRightY);
+        queryStatsPrint(&stats, outFile);
+
         free(range);
 
-        // freeing `footpathVisited` array
-        for (int i = 0; i < footpathVisited->n; i++) {
-            // setting to NULL because it is freed later
-            footpathVisited->A[i] = NULL;
-        }
-        free(footpathVisited->A);
-        free(footpathVisited);
+        // footpaths in `results` are freed with `qTree`
+        arrayFreeShallow(results);
+    }
+    free(linePtr);
+    qTreeFree(qTree);
+}
 
-        // freeing `results` array
-        for (int i = 0; i < results->n; i++) {
-            // setting to NULL because it is freed later
-            results->A[i] = NULL;
+// files the pairs of a proximity join are printed to
+typedef struct joinFiles {
+    FILE* outFile;
+    FILE* infoFile;
+} joinFiles_t;
+
+// prints the pair of leaves `a` and `b` `distance` metres apart to the files in `data`
+static void printJoinPair(qTreeNode_t* a, qTreeNode_t* b, double distance, void* data) {
+    joinFiles_t* files = data;
+
+    fprintf(files->outFile, "%.6lf %.6lf <-> %.6lf %.6lf --> %.2lf m\n",
+            a->point->x, a->point->y, b->point->x, b->point->y, distance);
+
+    fprintf(files->infoFile, "%.6lf %.6lf <-> %.6lf %.6lf\n",
+            a->point->x, a->point->y, b->point->x, b->point->y);
+    for (int i = 0; i < a->footpaths->n; i++)
+        footpathPrint(a->footpaths->A[i], files->infoFile);
+    for (int i = 0; i < b->footpaths->n; i++)
+        footpathPrint(b->footpaths->A[i], files->infoFile);
+}
+
+// function to report every pair of points of the qtree at most `distance` metres apart
+// prints the pairs to `outFile` and the footpaths of both points of every pair to `infoFile`
+void qTreeProximityJoin(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* distance, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    joinFiles_t files = {outFile, infoFile};
+    long nPairs = qTreeJoin(qTree, qTree, atof(distance), printJoinPair, &files);
+    fprintf(outFile, "pairs: %ld\n", nPairs);
+
+    qTreeFree(qTree);
+}
+
+// function to print density grids of the qtree through `inFile`, counting footpath
+// points or footpaths by `mode`, prints to `outFile`
+void qTreeDensityQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* mode, FILE *inFile, FILE *outFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, " ");
+        int width = atoi(strtok(NULL, " "));
+        int height = atoi(strtok(NULL, "\n"));
+
+        rectangle_t* rectangle = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        int* cells = malloc(width * height * sizeof(*cells));
+        assert(cells);
+        qTreeDensityGrid(qTree, rectangle, width, height, atoi(mode), cells);
+
+        fprintf(outFile, "%s %s %s %s %d %d -->\n", botLeftX, botLeftY, topRightX, topRightY,
+                width, height);
+        for (int row = 0; row < height; row++) {
+            for (int column = 0; column < width; column++)
+                fprintf(outFile, column == 0 ? "%d" : " %d", cells[row * width + column]);
+            fprintf(outFile, "\n");
         }
-        free(results->A);
-        free(results);
+
+        free(cells);
+        free(rectangle);
     }
     free(linePtr);
     qTreeFree(qTree);
 }
+
+// recursively appends the page of `node` and of its span and point to `pages`
+static void nodePages(qTreeNode_t* node, long pageSize, long** pages, int* nPages, int* size) {
+    if (*nPages + 3 > *size) {
+        *size *= 2;
+        *pages = realloc(*pages, *size * sizeof(**pages));
+        assert(*pages);
+    }
+    (*pages)[(*nPages)++] = (long)node / pageSize;
+    (*pages)[(*nPages)++] = (long)node->rectangle / pageSize;
+    if (node->point != NULL)
+        (*pages)[(*nPages)++] = (long)node->point / pageSize;
+
+    if (node->NW) {
+        nodePages(node->NW, pageSize, pages, nPages, size);
+        nodePages(node->NE, pageSize, pages, nPages, size);
+        nodePages(node->SW, pageSize, pages, nPages, size);
+        nodePages(node->SE, pageSize, pages, nPages, size);
+    }
+}
+
+// compares pages `a` and `b` for qsort
+static int comparePages(const void* a, const void* b) {
+    long pageA = *(long*)a, pageB = *(long*)b;
+    return (pageA > pageB) - (pageA < pageB);
+}
+
+// returns the number of memory pages holding the nodes walked in `qTree`, each
+// page a walk touches costs a TLB entry and the cache lines around its nodes
+static int countNodePages(qTree_t* qTree) {
+    long pageSize = sysconf(_SC_PAGESIZE);
+
+    // the frozen block is one run of pages
+    if (qTree->frozenNodes != NULL) {
+        long first = (long)qTree->frozenNodes / pageSize;
+        long last = (long)(qTree->frozenNodes + qTree->nFrozenNodes) / pageSize;
+        return last - first + 1;
+    }
+
+    int nPages = 0, size = 3;
+    long* pages = malloc(size * sizeof(*pages));
+    assert(pages);
+
+    nodePages(qTree->root, pageSize, &pages, &nPages, &size);
+    qsort(pages, nPages, sizeof(*pages), comparePages);
+
+    int nDistinct = 0;
+    for (int i = 0; i < nPages; i++) {
+        if (i == 0 || pages[i] != pages[i - 1])
+            nDistinct++;
+    }
+    free(pages);
+    return nDistinct;
+}
+
+// searches `qTree` for every point in `points`, only walking down to its leaf,
+// prints the time taken, footpaths found and pages holding nodes to `outFile` under `layout`
+static void benchmarkSearches(qTree_t* qTree, point_t* points, int nPoints,
+                              char* layout, FILE* outFile) {
+    struct timespec start, end;
+    long nFound = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < nPoints; i++) {
+        if (qTree->frozenNodes != NULL) {
+            array_t* footpaths = qTreeFrozenFind(qTree, &points[i]);
+            nFound += footpaths ? footpaths->n : 0;
+        } else {
+            qTreeNode_t* leaf = qTreeFindLeaf(qTree, &points[i]);
+            nFound += leaf ? leaf->footpaths->n : 0;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double micros = (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+    fprintf(outFile, "%s search: %d points || %ld footpaths || %.3lf us/point || %d node pages\n",
+            layout, nPoints, nFound, nPoints > 0 ? micros / nPoints : 0, countNodePages(qTree));
+}
+
+// answers every range query in `ranges` on `qTree`, prints the time taken,
+// footpaths found and pages holding nodes to `outFile` under `layout`
+static void benchmarkRanges(qTree_t* qTree, rectangle_t** ranges, int nRanges,
+                            char* layout, FILE* outFile) {
+    struct timespec start, end;
+    long nFound = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < nRanges; i++) {
+        array_t* footpathVisited = arrayCreate();
+        array_t* results = arrayCreate();
+
+        qTreeRange(qTree, ranges[i], footpathVisited, NULL, results);
+        nFound += results->n;
+
+        arrayFreeShallow(footpathVisited);
+        arrayFreeShallow(results);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double micros = (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+    fprintf(outFile, "%s range: %d queries || %ld footpaths || %.3lf us/query || %d node pages\n",
+            layout, nRanges, nFound, nRanges > 0 ? micros / nRanges : 0, countNodePages(qTree));
+}
+
+// function to time searches for the start and end point of every footpath and
+// the range queries through `inFile` on the qtree before and after it is frozen,
+// prints to `outFile`
+void qTreeFreezeBenchmark(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+    qTreeFinalize(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // queries are read up front so only answering them is timed
+    int nRanges = 0, size = 1;
+    rectangle_t** ranges = malloc(size * sizeof(*ranges));
+    assert(ranges);
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        if (nRanges == size) {
+            size *= 2;
+            ranges = realloc(ranges, size * sizeof(*ranges));
+            assert(ranges);
+        }
+        ranges[nRanges++] = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                                    strtold(topRightX, NULL), strtold(topRightY, NULL));
+    }
+    free(linePtr);
+
+    // points searched in the order of the data file, not of the tree
+    footpathStore_t* store = qTree->store;
+    int nPoints = 2 * store->n;
+    point_t* points = malloc((nPoints > 0 ? nPoints : 1) * sizeof(*points));
+    assert(points);
+    for (int row = 0; row < store->n; row++) {
+        points[2 * row] = (point_t){store->startLon[row], store->startLat[row]};
+        points[2 * row + 1] = (point_t){store->endLon[row], store->endLat[row]};
+    }
+
+    benchmarkSearches(qTree, points, nPoints, "finalized", outFile);
+    benchmarkRanges(qTree, ranges, nRanges, "finalized", outFile);
+
+    qTreeFreeze(qTree);
+    benchmarkSearches(qTree, points, nPoints, "frozen", outFile);
+    benchmarkRanges(qTree, ranges, nRanges, "frozen", outFile);
+
+    // the block only links its nodes by offsets so is used as is wherever it is
+    frozenNode_t* moved = malloc(qTree->nFrozenNodes * sizeof(*moved));
+    assert(moved);
+    memcpy(moved, qTree->frozenNodes, qTree->nFrozenNodes * sizeof(*moved));
+    free(qTree->frozenNodes);
+    qTree->frozenNodes = moved;
+    benchmarkSearches(qTree, points, nPoints, "moved", outFile);
+    benchmarkRanges(qTree, ranges, nRanges, "moved", outFile);
+
+    free(points);
+    for (int i = 0; i < nRanges; i++)
+        free(ranges[i]);
+    free(ranges);
+    qTreeFree(qTree);
+}
+
+// function to query qtree for region matches through `inFile` as qTreeRangeQuerying does,
+// answering all queries in one walk of the qtree, prints to `outFile` and `infoFile`
+void qTreeBatchedRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // lines are kept so every query can be printed once all are answered
+    int nRanges = 0, size = 1;
+    char** lines = malloc(size * sizeof(*lines));
+    rectangle_t** ranges = malloc(size * sizeof(*ranges));
+    assert(lines && ranges);
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        if (nRanges == size) {
+            size *= 2;
+            lines = realloc(lines, size * sizeof(*lines));
+            ranges = realloc(ranges, size * sizeof(*ranges));
+            assert(lines && ranges);
+        }
+
+        // formatting input read from a line
+        char* line = lines[nRanges] = strdup(linePtr);
+        assert(line);
+        char* botLeftX = strtok(line, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        ranges[nRanges++] = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                                    strtold(topRightX, NULL), strtold(topRightY, NULL));
+    }
+    free(linePtr);
+
+    trace_t** traces = malloc((nRanges > 0 ? nRanges : 1) * sizeof(*traces));
+    array_t** results = malloc((nRanges > 0 ? nRanges : 1) * sizeof(*results));
+    assert(traces && results);
+    for (int i = 0; i < nRanges; i++) {
+        traces[i] = traceCreate();
+        results[i] = arrayCreate();
+    }
+
+    // searches quad tree for points within every range at once
+    qTreeBatchRange(qTree, ranges, nRanges, traces, results);
+
+    for (int i = 0; i < nRanges; i++) {
+        // fields of the line were split by strtok in place
+        char* botLeftX = lines[i];
+        char* botLeftY = botLeftX + strlen(botLeftX) + 1;
+        char* topRightX = botLeftY + strlen(botLeftY) + 1;
+        char* topRightY = topRightX + strlen(topRightX) + 1;
+
+        printRangeQuery(outFile, infoFile, botLeftX, botLeftY, topRightX, topRightY,
+                        traces[i], results[i]);
+
+        // footpaths in `results` are freed with `qTree`
+        arrayFreeShallow(results[i]);
+        traceFree(traces[i]);
+        free(ranges[i]);
+        free(lines[i]);
+    }
+    free(results);
+    free(traces);
+    free(ranges);
+    free(lines);
+    qTreeFree(qTree);
+}
+
+// function to query qtree for region matches through `inFile` keeping only footpaths
+// meeting `predicate`, prints footpaths to `infoFile` and the cost of every query to `outFile`
+void qTreeFilteredRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, predicate_t* predicate, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted and summarized
+    qTreeFinalize(qTree);
+    attributeIndexBuild(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        // query range we use to search points within
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        array_t* results = arrayCreate();
+        filterStats_t stats;
+
+        // searches quad tree for points within range skipping subtrees ruled out by `predicate`
+        qTreeFilteredRange(qTree, range, predicate, &stats, results);
+
+        fprintf(infoFile, "%s %s %s %s\n", botLeftX, botLeftY, topRightX, topRightY);
+        for (int i = 0; i < results->n; i++)
+            footpathPrint(results->A[i], infoFile);
+
+        fprintf(outFile, "%s %s %s %s --> %d footpaths || ", botLeftX, botLeftY, topRightX,
+                topRightY, results->n);
+        filterStatsPrint(&stats, outFile);
+
+        free(range);
+
+        // footpaths in `results` are freed with `qTree`
+        arrayFreeShallow(results);
+    }
+    free(linePtr);
+    qTreeFree(qTree);
+}
+
+// function to query qtree for region matches through `inFile` at level of detail `resolution`
+// prints items to `infoFile` and the number of items and footpath points to `outFile`
+void qTreeLodRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* resolution, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        // query range we use to search points within
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        lodResults_t* results = lodResultsCreate();
+
+        // searches quad tree for points within range down to `resolution`
+        qTreeLodRange(qTree, range, strtold(resolution, NULL), results);
+
+        int nPoints = 0;
+        fprintf(infoFile, "%s %s %s %s\n", botLeftX, botLeftY, topRightX, topRightY);
+        for (int i = 0; i < results->n; i++) {
+            nPoints += results->items[i].count;
+            fprintf(infoFile, "%d ", results->items[i].count);
+            footpathPrint(results->items[i].footpath, infoFile);
+        }
+
+        fprintf(outFile, "%s %s %s %s --> %d items || %d footpath points\n", botLeftX, botLeftY,
+                topRightX, topRightY, results->n, nPoints);
+
+        free(range);
+        lodResultsFree(results);
+    }
+    free(linePtr);
+    qTreeFree(qTree);
+}
+
+// function to query qtree for region matches through `inFile` in pages limited by `budget`
+// prints footpaths of every page to `infoFile` and whether it was cut short to `outFile`
+void qTreeBudgetedRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, queryBudget_t* budget, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        // query range we use to search points within
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        resumeToken_t* token = resumeTokenCreate();
+        int truncated = 1;
+
+        // every page resumes the query where the page before it stopped
+        for (int page = 1; truncated; page++) {
+            array_t* results = arrayCreate();
+            truncated = qTreeBudgetedRange(qTree, range, budget, token, results);
+
+            fprintf(infoFile, "%s %s %s %s page %d\n", botLeftX, botLeftY, topRightX, topRightY, page);
+            for (int i = 0; i < results->n; i++)
+                footpathPrint(results->A[i], infoFile);
+
+            fprintf(outFile, "%s %s %s %s --> page %d || %d footpaths || %s\n", botLeftX, botLeftY,
+                    topRightX, topRightY, page, results->n, truncated ? "truncated" : "complete");
+
+            // footpaths in `results` are freed with `qTree`
+            arrayFreeShallow(results);
+        }
+
+        resumeTokenFree(token);
+        free(range);
+    }
+    free(linePtr);
+    qTreeFree(qTree);
+}
+
+// function to query qtree for region matches through `inFile` as qTreeRangeQuerying does,
+// with the qtree built by `threads` threads inserting at once, prints to `outFile` and `infoFile`
+void qTreeConcurrentRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* threads, FILE *inFile, FILE *outFile, FILE *infoFile) {
+    footpathStore_t* store = footpathStoreCreate();
+    array_t* footpaths = footpathLoad(dataFile, loaderThreads(), store);
+    qTree_t* qTree = qTreeCreate(getRootRectangle(footpaths, botLeftX, botLeftY, topRightX, topRightY),
+                                 store);
+    qTreeConcurrentBuild(qTree, footpaths, atoi(threads));
+
+    // footpaths are owned by `store`, which is now owned by `qTree`
+    arrayFreeShallow(footpaths);
+
+    answerRangeQueries(qTree, inFile, outFile, infoFile);
+    qTreeFree(qTree);
+}
+
+// function to query qtree for point region matches through `inFile` as qTreeExactQuerying
+// does, searching the compressed quadtree instead, prints to `outFile` and `infoFile`
+void qTreeCompressedExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // the compressed quadtree points into the footpath arrays of the finalized tree
+    qTreeFinalize(qTree);
+    compressedTree_t* compressed = compressedTreeBuild(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // variable to store which quadrants of tree visited to reach match, reused by every query
+    trace_t* trace = traceCreate();
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* x = strtok(linePtr, " ");
+        char* y = strtok(NULL, "\n");
+
+        traceReset(trace);
+
+        point_t* query = newPoint(atof(x), atof(y));
+        compressedTreeSearch(compressed, query, trace, infoFile, x, y);
+
+        if (trace->n == 0) {
+            fprintf(outFile, "%s %s --> %s\n", x, y, NOTFOUND);
+        } else {
+            fprintf(outFile, "%s %s --> ", x, y);
+            tracePrint(trace, outFile);
+        }
+        free(query);
+    }
+    free(linePtr);
+    traceFree(trace);
+    compressedTreeFree(compressed);
+    qTreeFree(qTree);
+}
+
+// function to query the footpath specialization of the generic quadtree for point region
+// matches through `inFile` as qTreeExactQuerying does, prints to `outFile` and `infoFile`
+void qTreeGenericExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    // the tree only refers to the footpaths, which are owned by `store`
+    footpathStore_t* store = footpathStoreCreate();
+    array_t* footpaths = footpathLoad(dataFile, loaderThreads(), store);
+    rectangle_t* rootRectangle = getRootRectangle(footpaths, botLeftX, botLeftY, topRightX, topRightY);
+    footpathTree_t* tree = footpathTreeCreate(*rootRectangle);
+    free(rootRectangle);
+
+    for (int i = 0; i < footpaths->n; i++) {
+        // both points share the footpath as in qTreeInsertFootpath
+        footpath_t* footpath = footpaths->A[i];
+        footpathTreeInsert(tree, (point_t){footpathGetStartLon(footpath), footpathGetStartLat(footpath)},
+                           footpath);
+        footpathTreeInsert(tree, (point_t){footpathGetEndLon(footpath), footpathGetEndLat(footpath)},
+                           footpath);
+    }
+    arrayFreeShallow(footpaths);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // variable to store which quadrants of tree visited to reach match, reused by every query
+    trace_t* trace = traceCreate();
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* x = strtok(linePtr, " ");
+        char* y = strtok(NULL, "\n");
+
+        traceReset(trace);
+
+        footpathTreeNode_t* leaf = footpathTreeSearch(tree, (point_t){atof(x), atof(y)}, trace);
+        if (leaf != NULL) {
+            fprintf(infoFile, "%s %s\n", x, y);
+            for (int i = 0; i < leaf->n; i++)
+                footpathPrint(leaf->payloads[i], infoFile);
+        }
+
+        if (trace->n == 0) {
+            fprintf(outFile, "%s %s --> %s\n", x, y, NOTFOUND);
+        } else {
+            fprintf(outFile, "%s %s --> ", x, y);
+            tracePrint(trace, outFile);
+        }
+    }
+    free(linePtr);
+    traceFree(trace);
+    footpathTreeFree(tree);
+    footpathStoreFree(store);
+}
+
+// function to query qtree for the point region and region matches in binary query file
+// `queryFileName` as qTreeExactQuerying and qTreeRangeQuerying do, prints to `outFile` and `infoFile`
+void qTreeBinaryQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, char* queryFileName, FILE *outFile, FILE *infoFile) {
+
+    queryFile_t* queryFile = queryFileOpen(queryFileName);
+    if (queryFile == NULL) {
+        fprintf(stderr, "%s is not a binary query file\n", queryFileName);
+        exit(EXIT_FAILURE);
+    }
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+    qTreeFreeze(qTree);
+    exactIndexBuild(qTree);
+
+    // reused by every query so queries are answered without allocating
+    trace_t* trace = traceCreate();
+    array_t* footpathVisited = arrayCreate();
+    array_t* results = arrayCreate();
+
+    for (int i = 0; i < queryFile->header->nQueries; i++) {
+        queryRecord_t* record = &queryFile->records[i];
+        traceReset(trace);
+
+        if (record->type == QUERY_POINT) {
+            char* x = queryFileText(queryFile, record, 0);
+            char* y = queryFileText(queryFile, record, 1);
+            point_t query = {record->values[0], record->values[1]};
+
+            qTreeSearch(qTree, &query, trace, infoFile, x, y);
+
+            if (trace->n == 0) {
+                fprintf(outFile, "%s %s --> %s\n", x, y, NOTFOUND);
+            } else {
+                fprintf(outFile, "%s %s --> ", x, y);
+                tracePrint(trace, outFile);
+            }
+        } else if (record->type == QUERY_RANGE) {
+            rectangle_t range = {record->values[0], record->values[1],
+                                record->values[2], record->values[3]};
+            footpathVisited->n = 0;
+            results->n = 0;
+
+            qTreeRange(qTree, &range, footpathVisited, trace, results);
+
+            printRangeQuery(outFile, infoFile, queryFileText(queryFile, record, 0),
+                            queryFileText(queryFile, record, 1), queryFileText(queryFile, record, 2),
+                            queryFileText(queryFile, record, 3), trace, results);
+        } else {
+            char* kind = record->type == QUERY_KNN ? "knn" : "radius";
+            char* x = queryFileText(queryFile, record, 0);
+            char* y = queryFileText(queryFile, record, 1);
+            char* value = queryFileText(queryFile, record, 2);
+            point_t query = {record->values[0], record->values[1]};
+            results->n = 0;
+
+            if (record->type == QUERY_KNN)
+                qTreeNearest(qTree, &query, (int)record->values[2], results);
+            else
+                qTreeRadius(qTree, &query, record->values[2], results);
+
+            fprintf(infoFile, "%s %s %s %s\n", kind, x, y, value);
+            for (int j = 0; j < results->n; j++)
+                footpathPrint(results->A[j], infoFile);
+
+            if (results->n == 0)
+                fprintf(outFile, "%s %s %s %s --> %s\n", kind, x, y, value, NOTFOUND);
+            else
+                fprintf(outFile, "%s %s %s %s --> %d\n", kind, x, y, value, results->n);
+        }
+    }
+
+    // footpaths in `footpathVisited` and `results` are freed with `qTree`
+    arrayFreeShallow(footpathVisited);
+    arrayFreeShallow(results);
+    traceFree(trace);
+    qTreeFree(qTree);
+    queryFileClose(queryFile);
+}
+
+// function to query qtree for the `k` footpaths within regions through `inFile` with the
+// largest or smallest, by `order`, numeric `attribute`, prints footpaths best first
+// to `infoFile` and the cost of every query to `outFile`
+void qTreeTopKRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, int attribute, int k, int order, FILE *inFile, FILE *outFile,
+                 FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted and summarized
+    qTreeFinalize(qTree);
+    attributeIndexBuild(qTree);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        // query range we use to search points within
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        array_t* results = arrayCreate();
+        topKStats_t stats;
+
+        // searches quad tree for the best footpaths, best bound first
+        qTreeRangeTopK(qTree, range, attribute, k, order, &stats, results);
+
+        fprintf(infoFile, "%s %s %s %s\n", botLeftX, botLeftY, topRightX, topRightY);
+        for (int i = 0; i < results->n; i++)
+            footpathPrint(results->A[i], infoFile);
+
+        fprintf(outFile, "%s %s %s %s --> %d footpaths || ", botLeftX, botLeftY, topRightX,
+                topRightY, results->n);
+        topKStatsPrint(&stats, outFile);
+
+        free(range);
+
+        // footpaths in `results` are freed with `qTree`
+        arrayFreeShallow(results);
+    }
+    free(linePtr);
+    qTreeFree(qTree);
+}
+
+// function to build the footpath graph of the qtree, joining points at most `tolerance`
+// metres apart, and find the shortest walks between pairs of footpaths through `inFile`
+// prints the size of the graph and the length of every walk to `outFile` and
+// the footpaths of every walk to `infoFile`
+void qTreeFootpathGraph(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* tolerance, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    footpathGraph_t* graph = footpathGraphBuild(qTree, atof(tolerance));
+
+    int* components = malloc((graph->nVertices > 0 ? graph->nVertices : 1) * sizeof(*components));
+    assert(components);
+    int nComponents = footpathGraphComponents(graph, components);
+    free(components);
+
+    fprintf(outFile, "vertices: %d || edges: %d || components: %d\n", graph->nVertices,
+            graph->nEdges / 2, nComponents);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* fromID = strtok(linePtr, " ");
+        char* toID = strtok(NULL, "\n");
+
+        int from = footpathGraphVertex(graph, atoi(fromID));
+        int to = footpathGraphVertex(graph, atoi(toID));
+
+        array_t* path = arrayCreate();
+        double length = from != -1 && to != -1 ? footpathGraphShortestPath(graph, from, to, path) : -1;
+
+        fprintf(infoFile, "%s %s\n", fromID, toID);
+        for (int i = 0; i < path->n; i++)
+            footpathPrint(path->A[i], infoFile);
+
+        if (length < 0)
+            fprintf(outFile, "%s %s --> %s\n", fromID, toID, NOTFOUND);
+        else
+            fprintf(outFile, "%s %s --> length: %.2f || footpaths: %d\n", fromID, toID, length, path->n);
+
+        // footpaths in `path` are freed with `qTree`
+        arrayFreeShallow(path);
+    }
+    free(linePtr);
+    footpathGraphFree(graph);
+    qTreeFree(qTree);
+}
+
+// function to report the shape of the qtree of the data file as it is queried,
+// prints JSON to `outFile`
+void qTreeAnalysis(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *outFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // compacted as it is for queries
+    qTreeFinalize(qTree);
+    qTreeFreeze(qTree);
+
+    qTreeAnalyze(qTree, outFile);
+    qTreeFree(qTree);
+}
+
+// function to follow a viewport moved to every range in `inFile` in turn
+// prints the number of footpaths that came into and went out of view to `outFile`
+// and the footpaths that came into view and IDs of those that went out to `infoFile`
+void qTreeViewportQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // no more points are inserted so the tree can be compacted
+    qTreeFinalize(qTree);
+
+    // nothing is in view before the first range
+    rectangle_t* previous = NULL;
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        // range the viewport is moved to
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        array_t* entered = arrayCreate();
+        array_t* left = arrayCreate();
+        viewportStats_t stats;
+
+        // searches quad tree only where the two viewports don't overlap
+        qTreeViewportDelta(qTree, previous, range, entered, left, &stats);
+
+        fprintf(infoFile, "%s %s %s %s\n", botLeftX, botLeftY, topRightX, topRightY);
+        for (int i = 0; i < entered->n; i++)
+            footpathPrint(entered->A[i], infoFile);
+        fprintf(infoFile, "left:");
+        for (int i = 0; i < left->n; i++)
+            fprintf(infoFile, " %d", footpathGetID(left->A[i]));
+        fprintf(infoFile, "\n");
+
+        fprintf(outFile, "%s %s %s %s --> entered: %d || left: %d || ", botLeftX, botLeftY,
+                topRightX, topRightY, entered->n, left->n);
+        viewportStatsPrint(&stats, outFile);
+
+        free(previous);
+        previous = range;
+
+        // footpaths in `entered` and `left` are freed with `qTree`
+        arrayFreeShallow(entered);
+        arrayFreeShallow(left);
+    }
+    free(previous);
+    free(linePtr);
+    qTreeFree(qTree);
+}
+
+// makes an octree from input file, its span in the plane from command line arguments
+// and its span in elevation from the footpaths, which are added to `store`
+footpathOctree_t* getOctree(char* fileName, char* botLeftX, char* botLeftY, char* topRightX,
+                            char* topRightY, footpathStore_t* store) {
+    array_t* footpaths = footpathLoad(fileName, loaderThreads(), store);
+    rectangle_t* rootRectangle = getRootRectangle(footpaths, botLeftX, botLeftY, topRightX, topRightY);
+    footpathOctree_t* tree = footpathOctreeCreate(footpathOctreeBounds(rootRectangle, footpaths));
+    free(rootRectangle);
+
+    for (int i = 0; i < footpaths->n; i++) {
+        // both points share the footpath as in qTreeInsertFootpath
+        footpath_t* footpath = footpaths->A[i];
+        footpathOctreeInsert(tree, footpathOctreeStart(footpath), footpath);
+        footpathOctreeInsert(tree, footpathOctreeEnd(footpath), footpath);
+    }
+    arrayFreeShallow(footpaths);
+    return tree;
+}
+
+// function to query the octree for points in space through `inFile` as qTreeExactQuerying
+// does, prints octants visited to `outFile` and footpaths found to `infoFile`
+void octreeExactQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    // the octree only refers to the footpaths, which are owned by `store`
+    footpathStore_t* store = footpathStoreCreate();
+    footpathOctree_t* tree = getOctree(dataFile, botLeftX, botLeftY, topRightX, topRightY, store);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // variable to store which octants of tree visited to reach match, reused by every query
+    trace_t* trace = traceCreate();
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* x = strtok(linePtr, " ");
+        char* y = strtok(NULL, " ");
+        char* z = strtok(NULL, "\n");
+
+        traceReset(trace);
+
+        footpathOctreeNode_t* leaf = footpathOctreeSearch(tree, (point3D_t){atof(x), atof(y), atof(z)},
+                                                          trace);
+        if (leaf != NULL) {
+            fprintf(infoFile, "%s %s %s\n", x, y, z);
+            for (int i = 0; i < leaf->n; i++)
+                footpathPrint(leaf->payloads[i], infoFile);
+        }
+
+        if (leaf == NULL) {
+            fprintf(outFile, "%s %s %s --> %s\n", x, y, z, NOTFOUND);
+        } else {
+            fprintf(outFile, "%s %s %s --> ", x, y, z);
+            tracePrintOctants(trace, outFile);
+        }
+    }
+    free(linePtr);
+    traceFree(trace);
+    footpathOctreeFree(tree);
+    footpathStoreFree(store);
+}
+
+// function to query the octree for footpaths with a point within boxes through `inFile`
+// prints the number of footpaths found to `outFile` and the footpaths to `infoFile`
+void octreeBoxQuerying(char *dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                char* topRightY, FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    // the octree only refers to the footpaths, which are owned by `store`
+    footpathStore_t* store = footpathStoreCreate();
+    footpathOctree_t* tree = getOctree(dataFile, botLeftX, botLeftY, topRightX, topRightY, store);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // reused by every query
+    footpathOctreeResults_t results = {NULL, 0, 0};
+    array_t* found = arrayCreate();
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* botLeftZ = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, " ");
+        char* topRightZ = strtok(NULL, "\n");
+
+        // query box we use to search points within, read as the points are so
+        // a box ending at an elevation holds the points at that elevation
+        box_t box = {atof(botLeftX), atof(botLeftY), atof(botLeftZ),
+                     atof(topRightX), atof(topRightY), atof(topRightZ)};
+
+        results.n = 0;
+        footpathOctreeRange(tree, &box, &results);
+
+        // a footpath with both points in the box is found twice, once by each copy
+        found->n = 0;
+        for (int i = 0; i < results.n; i++)
+            arrayAppend(found, results.A[i]);
+        arraySort(found);
+
+        fprintf(infoFile, "%s %s %s %s %s %s\n", botLeftX, botLeftY, botLeftZ, topRightX,
+                topRightY, topRightZ);
+        int nFound = 0;
+        for (int i = 0; i < found->n; i++) {
+            if (i > 0 && footpathGetID(found->A[i]) == footpathGetID(found->A[i - 1]))
+                continue;
+            footpathPrint(found->A[i], infoFile);
+            nFound++;
+        }
+
+        fprintf(outFile, "%s %s %s %s %s %s --> %d footpaths\n", botLeftX, botLeftY, botLeftZ,
+                topRightX, topRightY, topRightZ, nFound);
+    }
+    free(linePtr);
+    free(results.A);
+
+    // footpaths in `found` are freed with `tree`
+    arrayFreeShallow(found);
+    footpathOctreeFree(tree);
+    footpathStoreFree(store);
+}
+
+// function to query qtree for region matches through `inFile` after adding the footpaths
+// of csv `addedFile` and deleting the footpathIDs in `deletedFile`, one per line, through
+// a delta folded into the qtree once it holds `threshold` changes, prints as stage 4 does
+void qTreeDeltaRangeQuerying(char* dataFile, char* botLeftX, char* botLeftY, char* topRightX,
+                 char* topRightY, char* addedFile, char* deletedFile, int threshold,
+                 FILE *inFile, FILE *outFile, FILE *infoFile) {
+
+    qTree_t* qTree = getQuadTree(dataFile, botLeftX, botLeftY, topRightX, topRightY);
+
+    // the base is immutable from now on, changes go to the delta
+    // which is compacted on this thread so every run answers the same
+    qTreeFinalize(qTree);
+    deltaIndex_t* index = deltaIndexCreate(qTree, threshold, 0);
+
+    deltaIngestFile(index, addedFile);
+
+    FILE* deleted = fopen(deletedFile, "r");
+    assert(deleted);
+    int footpathID;
+    while (fscanf(deleted, "%d", &footpathID) == 1)
+        deltaDelete(index, footpathID);
+    fclose(deleted);
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+
+    // variable to store which quadrants of the base visited to reach matches, reused by every query
+    trace_t* trace = traceCreate();
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        // formatting input read from a line
+        char* botLeftX = strtok(linePtr, " ");
+        char* botLeftY = strtok(NULL, " ");
+        char* topRightX = strtok(NULL, " ");
+        char* topRightY = strtok(NULL, "\n");
+
+        traceReset(trace);
+
+        // query range we use to search points within
+        rectangle_t* range = newRectangle(strtold(botLeftX, NULL), strtold(botLeftY, NULL),
+                            strtold(topRightX, NULL), strtold(topRightY, NULL));
+
+        array_t* results = arrayCreate();
+
+        // footpaths found stay valid until the read ends, a compaction may swap the base after
+        deltaIndexBeginRead(index);
+        deltaIndexRange(index, range, trace, results);
+        printRangeQuery(outFile, infoFile, botLeftX, botLeftY, topRightX, topRightY,
+                        trace, results);
+        deltaIndexEndRead(index);
+
+        free(range);
+
+        // footpaths in `results` are freed with `index`
+        arrayFreeShallow(results);
+    }
+    free(linePtr);
+    traceFree(trace);
+    deltaIndexFree(index);
+}
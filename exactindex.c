@@ -0,0 +1,165 @@
+/* Project: PR QuadTrees
+* exactindex.c :
+*            = implementation of the module exactindex of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "exactindex.h"
+#include "quadtree.h"
+#include "trace.h"
+
+// returns the hash of `point` snapped to the EPSILON grid
+static unsigned long long exactHash(point_t* point) {
+    unsigned long long x = (long long)floor(point->x / EPSILON);
+    unsigned long long y = (long long)floor(point->y / EPSILON);
+
+    // mixing both coordinates so neighbouring points spread over the table
+    unsigned long long h = x * 0x9E3779B97F4A7C15ULL ^ (y + 0x632BE59BD9B4E019ULL);
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    return h;
+}
+
+// appends `depth` quadrant `codes` packed 2 bits each to the paths of `index`
+// returns the byte the path starts at
+static int exactPackPath(exactIndex_t* index, unsigned char* codes, int depth) {
+    int bytes = (depth + CODES_PER_BYTE - 1) / CODES_PER_BYTE;
+    if (index->pathsUsed + bytes > index->pathsSize) {
+        index->pathsSize = 2 * (index->pathsUsed + bytes);
+        index->paths = realloc(index->paths, index->pathsSize);
+        assert(index->paths);
+    }
+
+    int offset = index->pathsUsed;
+    memset(index->paths + offset, 0, bytes);
+    for (int i = 0; i < depth; i++)
+        index->paths[offset + i / CODES_PER_BYTE] |= codes[i] << (2 * (i % CODES_PER_BYTE));
+
+    index->pathsUsed += bytes;
+    return offset;
+}
+
+// inserts `leaf` reached through `depth` quadrant `codes` into `index`
+static void exactInsert(exactIndex_t* index, qTreeNode_t* leaf, unsigned char* codes, int depth) {
+    int slot = exactHash(leaf->point) & (index->size - 1);
+    while (index->entries[slot].leaf != NULL)
+        slot = (slot + 1) & (index->size - 1);
+
+    index->entries[slot].leaf = leaf;
+    index->entries[slot].depth = depth;
+    index->entries[slot].pathOffset = exactPackPath(index, codes, depth);
+    index->n++;
+}
+
+// recursively inserts every leaf below `node` reached through `depth` quadrant `codes`
+static void exactInsertNode(exactIndex_t* index, qTreeNode_t* node, unsigned char** codes,
+                            int* codesSize, int depth) {
+    if (node->point != NULL)
+        exactInsert(index, node, *codes, depth);
+
+    if (node->NW == NULL)
+        return;
+
+    if (depth + 1 > *codesSize) {
+        *codesSize *= 2;
+        *codes = realloc(*codes, *codesSize);
+        assert(*codes);
+    }
+
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        (*codes)[depth] = quadrant;
+        exactInsertNode(index, getQuadrant(node, quadrant), codes, codesSize, depth + 1);
+    }
+}
+
+// counts the points below `node`
+static int exactCountPoints(qTreeNode_t* node) {
+    if (node->NW == NULL)
+        return node->point != NULL;
+
+    return exactCountPoints(node->NW) + exactCountPoints(node->NE) +
+        exactCountPoints(node->SW) + exactCountPoints(node->SE);
+}
+
+// builds an exact index for `qTree` used by qTreeSearch from now on
+// the index is dropped when a point is inserted into `qTree`
+void exactIndexBuild(qTree_t* qTree) {
+    if (qTree->exactIndex != NULL)
+        exactIndexFree(qTree->exactIndex);
+
+    exactIndex_t* index = malloc(sizeof(*index));
+    assert(index);
+
+    // keeping the table at most half full
+    int nPoints = exactCountPoints(qTree->root);
+    index->size = 1;
+    while (index->size < 2 * nPoints)
+        index->size <<= 1;
+
+    index->entries = calloc(index->size, sizeof(*index->entries));
+    index->pathsSize = nPoints + 1;
+    index->paths = malloc(index->pathsSize);
+    assert(index->entries && index->paths);
+    index->pathsUsed = 0;
+    index->n = 0;
+
+    int codesSize = 64;
+    unsigned char* codes = malloc(codesSize);
+    assert(codes);
+    exactInsertNode(index, qTree->root, &codes, &codesSize, 0);
+    free(codes);
+
+    qTree->exactIndex = index;
+}
+
+// searches `index` for `point`, if found appends quadrants accessed to reach
+// `point` to `trace` and prints its footpaths to `infoFile` as qTreeSearch does
+// returns 1 if found, 0 if `point` has to be searched for in the tree
+int exactIndexSearch(exactIndex_t* index, point_t* point, trace_t* trace,
+                    FILE* infoFile, char* xBuffer, char* yBuffer) {
+    int slot = exactHash(point) & (index->size - 1);
+
+    for (; index->entries[slot].leaf != NULL; slot = (slot + 1) & (index->size - 1)) {
+        exactEntry_t* entry = &index->entries[slot];
+        qTreeNode_t* leaf = entry->leaf;
+
+        // only a point equal to the point of the leaf is sure to take the same
+        // path down the tree, points merely within EPSILON are left to the tree
+        if (leaf->point->x != point->x || leaf->point->y != point->y)
+            continue;
+
+        // root is never traced unless it is the leaf
+        if (entry->depth == 0)
+            traceAppend(trace, leaf->quadrant);
+
+        for (int i = 0; i < entry->depth; i++) {
+            int code = (index->paths[entry->pathOffset + i / CODES_PER_BYTE] >>
+                        (2 * (i % CODES_PER_BYTE))) & 3;
+            traceAppend(trace, code);
+        }
+
+        // printing all footpaths in found point
+        fprintf(infoFile, "%s %s\n", xBuffer, yBuffer);
+        for (int i = 0; i < leaf->footpaths->n; i++)
+            footpathPrint(leaf->footpaths->A[i], infoFile);
+
+        return 1;
+    }
+    return 0;
+}
+
+// free allocated memory used by `index`
+void exactIndexFree(exactIndex_t* index) {
+    free(index->entries);
+    free(index->paths);
+    free(index);
+}
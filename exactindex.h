@@ -0,0 +1,50 @@
+/* Project: PR QuadTrees
+* exactindex.h :
+*            = interface of the module exactindex of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _EXACTINDEX_H_
+#define _EXACTINDEX_H_
+
+#include <stdio.h>
+
+#include "quadtree.h"
+#include "trace.h"
+
+// quadrant codes per byte of a packed quadrant path, 2 bits each
+#define CODES_PER_BYTE 4
+
+// point of a leaf in the hash table of an exact index
+typedef struct exactEntry {
+    qTreeNode_t* leaf;  // NULL for an empty slot
+    int pathOffset;  // byte of the packed quadrant path in the paths of the index
+    int depth;  // quadrants in the path from the root to `leaf`
+} exactEntry_t;
+
+// hash table from the points of a qTree to their leaf and quadrant path
+typedef struct exactIndex {
+    exactEntry_t* entries;  // open addressing table of `size` slots
+    int size;  // power of 2, at least twice the number of points
+    int n;  // points in the table
+    unsigned char* paths;  // quadrant paths of every point packed 2 bits per level
+    int pathsSize;
+    int pathsUsed;
+} exactIndex_t;
+
+// builds an exact index for `qTree` used by qTreeSearch from now on
+// the index is dropped when a point is inserted into `qTree`
+void exactIndexBuild(qTree_t* qTree);
+
+// searches `index` for `point`, if found appends quadrants accessed to reach
+// `point` to `trace` and prints its footpaths to `infoFile` as qTreeSearch does
+// returns 1 if found, 0 if `point` has to be searched for in the tree
+int exactIndexSearch(exactIndex_t* index, point_t* point, trace_t* trace,
+                    FILE* infoFile, char* xBuffer, char* yBuffer);
+
+// free allocated memory used by `index`
+void exactIndexFree(exactIndex_t* index);
+
+#endif
@@ -0,0 +1,406 @@
+/* Project: PR QuadTrees
+* filter.c :
+*            = implementation of the module filter of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "filter.h"
+#include "quadtree.h"
+#include "array.h"
+#include "dictionary.h"
+#include "store.h"
+
+// column names of the string and numeric attributes in the data file
+static char* stringAttributeNames[N_STRING_ATTRIBUTES] = {"asset_type", "segside"};
+static char* numericAttributeNames[N_NUMERIC_ATTRIBUTES] = {"deltaz", "distance", "grade1in",
+                                                        "rlmax", "rlmin", "statusid"};
+
+// returns string `attribute` of `footpath`, read from the columns of its store
+char* footpathStringAttribute(footpath_t* footpath, int attribute) {
+    footpathStore_t* store = footpath->store;
+    switch (attribute) {
+        case ATTRIBUTE_ASSET_TYPE:
+            return dictionaryDecode(store->assetTypes, store->assetType[footpath->row]);
+        case ATTRIBUTE_SEGSIDE:
+            return dictionaryDecode(store->segSides, store->segSide[footpath->row]);
+    }
+    assert(0);
+    return NULL;
+}
+
+// returns the code of string `attribute` of `footpath` in the dictionary of its store
+static int footpathStringCode(footpath_t* footpath, int attribute) {
+    footpathStore_t* store = footpath->store;
+    switch (attribute) {
+        case ATTRIBUTE_ASSET_TYPE:
+            return store->assetType[footpath->row];
+        case ATTRIBUTE_SEGSIDE:
+            return store->segSide[footpath->row];
+    }
+    assert(0);
+    return -1;
+}
+
+// returns the dictionary of string `attribute` of `store`
+static dictionary_t* storeDictionary(footpathStore_t* store, int attribute) {
+    switch (attribute) {
+        case ATTRIBUTE_ASSET_TYPE:
+            return store->assetTypes;
+        case ATTRIBUTE_SEGSIDE:
+            return store->segSides;
+    }
+    assert(0);
+    return NULL;
+}
+
+// returns numeric `attribute` of `footpath`, read from the columns of its store
+double footpathNumericAttribute(footpath_t* footpath, int attribute) {
+    footpathStore_t* store = footpath->store;
+    switch (attribute) {
+        case ATTRIBUTE_DELTAZ:
+            return store->deltaZ[footpath->row];
+        case ATTRIBUTE_DISTANCE:
+            return store->distance[footpath->row];
+        case ATTRIBUTE_GRADE1IN:
+            return store->grade1in[footpath->row];
+        case ATTRIBUTE_RLMAX:
+            return store->rlMax[footpath->row];
+        case ATTRIBUTE_RLMIN:
+            return store->rlMin[footpath->row];
+        case ATTRIBUTE_STATUSID:
+            return store->statusID[footpath->row];
+    }
+    assert(0);
+    return 0;
+}
+
+// returns the numeric attribute with column name `name`, -1 if there is none
+int numericAttributeLookup(char* name) {
+    for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+        if (strcmp(name, numericAttributeNames[a]) == 0)
+            return a;
+    }
+    return -1;
+}
+
+// returns the bit of `code` in the bitmap of a node summary
+static unsigned long long summaryBit(int code) {
+    return 1ULL << (code < SUMMARY_CODES ? code : SUMMARY_CODES - 1);
+}
+
+// recursively counts the nodes below `node`
+static int filterCountNodes(qTreeNode_t* node) {
+    if (node->NW == NULL)
+        return 1;
+
+    return 1 + filterCountNodes(node->NW) + filterCountNodes(node->NE) +
+        filterCountNodes(node->SW) + filterCountNodes(node->SE);
+}
+
+// recursively gives `node` and every node below it a summary from `index`
+// string attributes are summarized by their codes in the store of the footpaths
+static void summarizeNode(attributeIndex_t* index, qTreeNode_t* node) {
+    nodeSummary_t* summary = &index->summaries[index->nSummaries++];
+    node->summary = summary;
+
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++)
+        summary->codes[a] = 0;
+    for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+        summary->min[a] = INFINITY;
+        summary->max[a] = -INFINITY;
+    }
+
+    if (node->point != NULL) {
+        for (int i = 0; i < node->footpaths->n; i++) {
+            footpath_t* footpath = node->footpaths->A[i];
+            for (int a = 0; a < N_STRING_ATTRIBUTES; a++)
+                summary->codes[a] |= summaryBit(footpathStringCode(footpath, a));
+            for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+                double value = footpathNumericAttribute(footpath, a);
+                summary->min[a] = fmin(summary->min[a], value);
+                summary->max[a] = fmax(summary->max[a], value);
+            }
+        }
+    }
+
+    if (node->NW == NULL)
+        return;
+
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        qTreeNode_t* child = getQuadrant(node, quadrant);
+        summarizeNode(index, child);
+
+        for (int a = 0; a < N_STRING_ATTRIBUTES; a++)
+            summary->codes[a] |= child->summary->codes[a];
+        for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+            summary->min[a] = fmin(summary->min[a], child->summary->min[a]);
+            summary->max[a] = fmax(summary->max[a], child->summary->max[a]);
+        }
+    }
+}
+
+// builds the attribute index of a finalized `qTree`, giving every node a summary
+// of the attributes of the footpaths in its subtree
+void attributeIndexBuild(qTree_t* qTree) {
+    // summaries would go stale if points were inserted
+    assert(qTree->footpathPool != NULL);
+
+    if (qTree->attributes != NULL)
+        return;
+
+    attributeIndex_t* index = malloc(sizeof(*index));
+    assert(index);
+
+    index->summaries = malloc(filterCountNodes(qTree->root) * sizeof(*index->summaries));
+    assert(index->summaries);
+    index->nSummaries = 0;
+    summarizeNode(index, qTree->root);
+
+    qTree->attributes = index;
+}
+
+// free allocated memory used by `index`
+void attributeIndexFree(attributeIndex_t* index) {
+    free(index->summaries);
+    free(index);
+}
+
+// creates and returns a predicate every footpath meets
+predicate_t* predicateCreate() {
+    predicate_t* predicate = malloc(sizeof(*predicate));
+    assert(predicate);
+
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++) {
+        predicate->values[a] = NULL;
+        predicate->nValues[a] = 0;
+    }
+    for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+        predicate->min[a] = -INFINITY;
+        predicate->max[a] = INFINITY;
+    }
+    return predicate;
+}
+
+// allows `value` for string `attribute` of `predicate`, every other value
+// not allowed by an earlier call is ruled out
+void predicateIn(predicate_t* predicate, int attribute, char* value) {
+    int n = predicate->nValues[attribute];
+    predicate->values[attribute] = realloc(predicate->values[attribute],
+                                        (n + 1) * sizeof(*predicate->values[attribute]));
+    assert(predicate->values[attribute]);
+
+    predicate->values[attribute][n] = strdup(value);
+    assert(predicate->values[attribute][n]);
+    predicate->nValues[attribute]++;
+}
+
+// restricts numeric `attribute` of `predicate` to between `min` and `max` inclusive
+void predicateRange(predicate_t* predicate, int attribute, double min, double max) {
+    predicate->min[attribute] = fmax(predicate->min[attribute], min);
+    predicate->max[attribute] = fmin(predicate->max[attribute], max);
+}
+
+// adds `term` to `predicate`, either `name=value|value..` for a string attribute
+// or `name=min:max` for a numeric attribute with either bound left out if unbounded
+// names are the column names of the data file, returns 0 if `term` isn't valid
+int predicateParse(predicate_t* predicate, char* term) {
+    char* equals = strchr(term, '=');
+    if (equals == NULL)
+        return 0;
+
+    int nameLength = equals - term;
+    char* value = equals + 1;
+
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++) {
+        if (strlen(stringAttributeNames[a]) != nameLength ||
+            strncmp(term, stringAttributeNames[a], nameLength) != 0)
+            continue;
+
+        // values are separated by '|', an empty value is allowed
+        char* values = strdup(value);
+        assert(values);
+        char* rest = values;
+        char* field;
+        while ((field = strsep(&rest, "|")) != NULL)
+            predicateIn(predicate, a, field);
+        free(values);
+        return 1;
+    }
+
+    for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+        if (strlen(numericAttributeNames[a]) != nameLength ||
+            strncmp(term, numericAttributeNames[a], nameLength) != 0)
+            continue;
+
+        char* colon = strchr(value, ':');
+        if (colon == NULL)
+            return 0;
+
+        double min = colon == value ? -INFINITY : atof(value);
+        double max = colon[1] == '\0' ? INFINITY : atof(colon + 1);
+        predicateRange(predicate, a, min, max);
+        return 1;
+    }
+    return 0;
+}
+
+// free allocated memory used by `predicate`
+void predicateFree(predicate_t* predicate) {
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++) {
+        for (int i = 0; i < predicate->nValues[a]; i++)
+            free(predicate->values[a][i]);
+        free(predicate->values[a]);
+    }
+    free(predicate);
+}
+
+// state shared by every node of a filtered range query
+typedef struct filter {
+    rectangle_t* range;
+    predicate_t* predicate;
+    unsigned long long codes[N_STRING_ATTRIBUTES];  // bitmap of the codes allowed by `predicate`
+    int* allowed[N_STRING_ATTRIBUTES];  // codes allowed by `predicate`, NULL when any code is
+    int nAllowed[N_STRING_ATTRIBUTES];
+    filterStats_t* stats;
+    array_t* found;
+} filter_t;
+
+// returns whether `footpath` meets the predicate of `filter`
+// string attributes are compared by their codes in the store
+static int filterMatch(filter_t* filter, footpath_t* footpath) {
+    for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+        double value = footpathNumericAttribute(footpath, a);
+        if (value < filter->predicate->min[a] || value > filter->predicate->max[a])
+            return 0;
+    }
+
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++) {
+        if (filter->allowed[a] == NULL)
+            continue;
+
+        int code = footpathStringCode(footpath, a);
+        int found = 0;
+        for (int i = 0; i < filter->nAllowed[a] && !found; i++)
+            found = filter->allowed[a][i] == code;
+        if (!found)
+            return 0;
+    }
+    return 1;
+}
+
+// returns whether no footpath summarized by `summary` can meet the predicate of `filter`
+static int filterRulesOut(filter_t* filter, nodeSummary_t* summary) {
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++) {
+        if ((summary->codes[a] & filter->codes[a]) == 0)
+            return 1;
+    }
+    for (int a = 0; a < N_NUMERIC_ATTRIBUTES; a++) {
+        if (summary->max[a] < filter->predicate->min[a] || summary->min[a] > filter->predicate->max[a])
+            return 1;
+    }
+    return 0;
+}
+
+// recursively appends the footpaths of points below `node` within the range
+// of `filter` meeting its predicate to the footpaths found by `filter`
+static void filterNode(filter_t* filter, qTreeNode_t* node) {
+    rectangle_t* span = node->rectangle;
+    rectangle_t* range = filter->range;
+
+    if (node->count == 0 || span->topRightX < range->botLeftX || span->botLeftX > range->topRightX ||
+        span->topRightY < range->botLeftY || span->botLeftY > range->topRightY)
+        return;
+
+    filter->stats->nodesVisited++;
+
+    if (filterRulesOut(filter, node->summary)) {
+        filter->stats->nodesPruned++;
+        return;
+    }
+
+    if (node->point != NULL) {
+        if (inRectangleStage4(range, node->point)) {
+            for (int i = 0; i < node->footpaths->n; i++) {
+                filter->stats->footpathsTested++;
+                if (filterMatch(filter, node->footpaths->A[i]))
+                    arrayAppend(filter->found, node->footpaths->A[i]);
+            }
+        }
+        return;
+    }
+
+    if (node->NW) {
+        filterNode(filter, node->SW);
+        filterNode(filter, node->NW);
+        filterNode(filter, node->NE);
+        filterNode(filter, node->SE);
+    }
+}
+
+// searches `qTree` for points within `range` whose footpaths meet `predicate`,
+// skipping subtrees whose summary rules `predicate` out, building the
+// attribute index of `qTree` on first use
+// stores unique footpaths meeting `predicate` into `results` sorted by footpathID
+// and what the query cost into `stats`
+array_t* qTreeFilteredRange(qTree_t* qTree, rectangle_t* range, predicate_t* predicate,
+                        filterStats_t* stats, array_t* results) {
+    memset(stats, 0, sizeof(*stats));
+    if (qTree->attributes == NULL)
+        attributeIndexBuild(qTree);
+
+    filter_t filter;
+    filter.range = range;
+    filter.predicate = predicate;
+    filter.stats = stats;
+    filter.found = arrayCreate();
+
+    // allowed strings become the codes they have in the store of `qTree` once per query,
+    // strings not in the store can't be met by any footpath
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++) {
+        filter.allowed[a] = NULL;
+        filter.nAllowed[a] = 0;
+        if (predicate->values[a] == NULL) {
+            filter.codes[a] = ~0ULL;
+            continue;
+        }
+
+        filter.codes[a] = 0;
+        filter.allowed[a] = malloc((predicate->nValues[a] > 0 ? predicate->nValues[a] : 1) *
+                                   sizeof(*filter.allowed[a]));
+        assert(filter.allowed[a]);
+        for (int i = 0; i < predicate->nValues[a]; i++) {
+            int code = dictionaryLookup(storeDictionary(qTree->store, a), predicate->values[a][i]);
+            if (code != -1) {
+                filter.codes[a] |= summaryBit(code);
+                filter.allowed[a][filter.nAllowed[a]++] = code;
+            }
+        }
+    }
+
+    filterNode(&filter, qTree->root);
+
+    arraySort(filter.found);
+    for (int i = 0; i < filter.found->n; i++) {
+        if (i == 0 || footpathGetID(filter.found->A[i]) != footpathGetID(filter.found->A[i - 1]))
+            arrayAppend(results, filter.found->A[i]);
+    }
+
+    arrayFreeShallow(filter.found);
+    for (int a = 0; a < N_STRING_ATTRIBUTES; a++)
+        free(filter.allowed[a]);
+    return results;
+}
+
+// prints `stats` to `outFile`
+void filterStatsPrint(filterStats_t* stats, FILE* outFile) {
+    fprintf(outFile, "nodes visited: %d || nodes pruned: %d || footpaths tested: %d\n",
+            stats->nodesVisited, stats->nodesPruned, stats->footpathsTested);
+}
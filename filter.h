@@ -0,0 +1,108 @@
+/* Project: PR QuadTrees
+* filter.h :
+*            = interface of the module filter of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _FILTER_H_
+#define _FILTER_H_
+
+#include <stdio.h>
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+
+// string attributes of a footpath, dictionary encoded by the store of its qTree
+#define ATTRIBUTE_ASSET_TYPE 0
+#define ATTRIBUTE_SEGSIDE 1
+#define N_STRING_ATTRIBUTES 2
+
+// numeric attributes of a footpath
+#define ATTRIBUTE_DELTAZ 0
+#define ATTRIBUTE_DISTANCE 1
+#define ATTRIBUTE_GRADE1IN 2
+#define ATTRIBUTE_RLMAX 3
+#define ATTRIBUTE_RLMIN 4
+#define ATTRIBUTE_STATUSID 5
+#define N_NUMERIC_ATTRIBUTES 6
+
+// codes with a bit of their own in a node summary, later codes share the last bit
+#define SUMMARY_CODES 64
+
+// attributes of every footpath stored in the subtree of a node
+typedef struct nodeSummary {
+    unsigned long long codes[N_STRING_ATTRIBUTES];  // bitmap of the codes present
+    double min[N_NUMERIC_ATTRIBUTES];
+    double max[N_NUMERIC_ATTRIBUTES];
+} nodeSummary_t;
+
+// summaries of the nodes of a qTree, string attributes by their codes in its store
+typedef struct attributeIndex {
+    nodeSummary_t* summaries;  // summary of every node, pointed to by the nodes
+    int nSummaries;
+} attributeIndex_t;
+
+// conditions every footpath of a filtered range query must meet
+typedef struct predicate {
+    char** values[N_STRING_ATTRIBUTES];  // allowed strings, NULL when any string is
+    int nValues[N_STRING_ATTRIBUTES];
+    double min[N_NUMERIC_ATTRIBUTES];  // -INFINITY and INFINITY when unbounded
+    double max[N_NUMERIC_ATTRIBUTES];
+} predicate_t;
+
+// what a filtered range query cost
+typedef struct filterStats {
+    int nodesVisited;  // nodes overlapping the range
+    int nodesPruned;  // nodes whose summary rules out the predicate
+    int footpathsTested;  // footpaths tested against the predicate
+} filterStats_t;
+
+// builds the attribute index of a finalized `qTree`, giving every node a summary
+// of the attributes of the footpaths in its subtree
+void attributeIndexBuild(qTree_t* qTree);
+
+// free allocated memory used by `index`
+void attributeIndexFree(attributeIndex_t* index);
+
+// returns string `attribute` of `footpath`, read from the columns of its store
+char* footpathStringAttribute(footpath_t* footpath, int attribute);
+
+// returns numeric `attribute` of `footpath`, read from the columns of its store
+double footpathNumericAttribute(footpath_t* footpath, int attribute);
+
+// returns the numeric attribute with column name `name`, -1 if there is none
+int numericAttributeLookup(char* name);
+
+// creates and returns a predicate every footpath meets
+predicate_t* predicateCreate();
+
+// allows `value` for string `attribute` of `predicate`, every other value
+// not allowed by an earlier call is ruled out
+void predicateIn(predicate_t* predicate, int attribute, char* value);
+
+// restricts numeric `attribute` of `predicate` to between `min` and `max` inclusive
+void predicateRange(predicate_t* predicate, int attribute, double min, double max);
+
+// adds `term` to `predicate`, either `name=value|value..` for a string attribute
+// or `name=min:max` for a numeric attribute with either bound left out if unbounded
+// names are the column names of the data file, returns 0 if `term` isn't valid
+int predicateParse(predicate_t* predicate, char* term);
+
+// free allocated memory used by `predicate`
+void predicateFree(predicate_t* predicate);
+
+// searches `qTree` for points within `range` whose footpaths meet `predicate`,
+// skipping subtrees whose summary rules `predicate` out, building the
+// attribute index of `qTree` on first use
+// stores unique footpaths meeting `predicate` into `results` sorted by footpathID
+// and what the query cost into `stats`
+array_t* qTreeFilteredRange(qTree_t* qTree, rectangle_t* range, predicate_t* predicate,
+                        filterStats_t* stats, array_t* results);
+
+// prints `stats` to `outFile`
+void filterStatsPrint(filterStats_t* stats, FILE* outFile);
+
+#endif
@@ -0,0 +1,81 @@
+/* Project: PR QuadTrees
+* footpathtree.h :
+*            = interface of the module footpathtree of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _FOOTPATHTREE_H_
+#define _FOOTPATHTREE_H_
+
+#include "data.h"
+#include "store.h"
+#include "quadtree.h"
+#include "array.h"
+#include "generic.h"
+#include "octree.h"
+
+// returns the ID footpaths of a footpathTree_t leaf are ordered by
+static inline int footpathTreeID(footpath_t* footpath) {
+    return footpathGetID(footpath);
+}
+
+// compares footpaths `a` and `b` by ID with footpathCmpID
+static inline int footpathTreeCompare(footpath_t* a, footpath_t* b) {
+    return footpathCmpID(a, b);
+}
+
+// releases a footpath of a leaf, which is owned by its store and not the tree
+static inline void footpathTreeRelease(footpath_t* footpath) {
+    (void)footpath;
+}
+
+// quadtree of footpaths storing them as qTree_t does, both points of a footpath
+// sharing it, the footpaths are owned by their store, which has to outlive the tree
+GENERIC_QTREE_DEFINE(footpathTree, footpath_t*, footpathTreeID, footpathTreeCompare, footpathTreeRelease)
+
+// octree of footpaths storing them as footpathTree_t does, with elevation as the third axis
+GENERIC_TREE_DEFINE(footpathOctree, oct, OCTANTS, footpath_t*, footpathTreeID, footpathTreeCompare,
+                    footpathTreeRelease)
+
+// returns the start point of `footpath` in space
+// only the lowest and highest elevation along a footpath are known, so one that
+// rises by `deltaZ` is taken to start at `rlMin` and one that falls at `rlMax`
+static inline point3D_t footpathOctreeStart(footpath_t* footpath) {
+    footpathStore_t* store = footpath->store;
+    int row = footpath->row;
+    return (point3D_t){store->startLon[row], store->startLat[row],
+                       store->deltaZ[row] >= 0 ? store->rlMin[row] : store->rlMax[row]};
+}
+
+// returns the end point of `footpath` in space, at the other elevation of its start
+static inline point3D_t footpathOctreeEnd(footpath_t* footpath) {
+    footpathStore_t* store = footpath->store;
+    int row = footpath->row;
+    return (point3D_t){store->endLon[row], store->endLat[row],
+                       store->deltaZ[row] >= 0 ? store->rlMax[row] : store->rlMin[row]};
+}
+
+// returns the box spanning `rectangle` in the plane and every elevation of
+// `footpaths`, the top moved up by a hair so every point is inside as octContains
+// sees it, a unit height if `footpaths` is empty or flat
+static inline box_t footpathOctreeBounds(rectangle_t* rectangle, array_t* footpaths) {
+    long double lowZ = 0, highZ = 0;
+    for (int i = 0; i < footpaths->n; i++) {
+        footpathStore_t* store = footpaths->A[i]->store;
+        int row = footpaths->A[i]->row;
+        long double low = store->rlMin[row] < store->rlMax[row] ? store->rlMin[row] : store->rlMax[row];
+        long double high = store->rlMin[row] < store->rlMax[row] ? store->rlMax[row] : store->rlMin[row];
+        if (i == 0 || low < lowZ)
+            lowZ = low;
+        if (i == 0 || high > highZ)
+            highZ = high;
+    }
+
+    long double margin = highZ > lowZ ? (highZ - lowZ) * BOUNDS_MARGIN : 1;
+    return (box_t){rectangle->botLeftX, rectangle->botLeftY, lowZ,
+                   rectangle->topRightX, rectangle->topRightY, highZ + margin};
+}
+
+#endif
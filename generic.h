@@ -0,0 +1,316 @@
+/* Project: PR QuadTrees
+* generic.h :
+*            = interface of the module generic of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _GENERIC_H_
+#define _GENERIC_H_
+
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#include "quadtree.h"
+#include "trace.h"
+
+// initial number of payloads a leaf has room for
+#define GENERIC_INIT_SIZE 2
+
+// children of a node of a tree in the plane, the root is coded NO_QUADRANT
+#define QUADRANTS 4
+
+// quadrant geometry, the spans and points of a tree in the plane
+// every rule is the one of quadtree.c, so a generic quadtree places, splits
+// and grows exactly as qTree_t does
+typedef rectangle_t quadSpan_t;
+typedef point_t quadPoint_t;
+
+// returns 0,1,2 or 3 for the quadrant of `rectangle` `point` belongs in
+// returns -1 if point doesn't belong in either quadrant
+static inline int quadChild(rectangle_t* rectangle, point_t* point) {
+    return rectangleQuadrant(rectangle, point);
+}
+
+// returns the span of `quadrant` of `rectangle`
+static inline rectangle_t quadChildSpan(rectangle_t* rectangle, int quadrant) {
+    return rectangleQuadrantSpan(rectangle, quadrant);
+}
+
+// returns whether `point` belongs in `rectangle` as inRectangle sees it
+static inline int quadContains(rectangle_t* rectangle, point_t* point) {
+    return inRectangle(rectangle, point);
+}
+
+// returns whether `point` is within `range`, borders included
+static inline int quadHolds(rectangle_t* range, point_t* point) {
+    return inRectangleStage4(range, point);
+}
+
+// returns whether `rectangle` has any point in common with `range`, borders included
+static inline int quadOverlaps(rectangle_t* rectangle, rectangle_t* range) {
+    return rectangle->botLeftX <= range->topRightX && rectangle->topRightX >= range->botLeftX &&
+        rectangle->botLeftY <= range->topRightY && rectangle->topRightY >= range->botLeftY;
+}
+
+// returns whether points `a` and `b` are the same point to within EPSILON
+static inline int quadSame(point_t* a, point_t* b) {
+    return samePoint(a, b);
+}
+
+// returns the span twice the size of `rectangle` growing towards `point`,
+// with the quadrant `rectangle` takes in it stored in `quadrant`
+static inline rectangle_t quadGrow(rectangle_t* rectangle, point_t* point, int* quadrant) {
+    return rectangleGrow(rectangle, point, quadrant);
+}
+
+// defines a PR tree `name##_t` storing values of type `payload_t` in its leaves,
+// with `payloadID(payload)` returning the int ID of a payload, `payloadCompare(a, b)`
+// ordering two payloads like strcmp and `payloadFree(payload)` releasing one
+// all three are called directly from functions specialized for `payload_t`, so
+// nothing is dispatched at run time, and payloads are stored inline in the sorted
+// array of their leaf, which only costs a pointer per entry if `payload_t` is one
+//
+// the tree is specialized on its dimension by `geometry`, quad or oct, which names
+// its span and point types `geometry##Span_t` and `geometry##Point_t` and the
+// functions splitting and comparing them, every node having `children` children
+// the root is coded `children`, which is NO_QUADRANT or NO_OCTANT
+//
+// the nodes split, search and trace exactly as the nodes of qTree_t do, but hold
+// their span and point inline and the children of a node in one block
+//
+// defines:
+//   name##Node_t, name##_t, name##Results_t
+//   name##_t* name##Create(span_t span)
+//   void name##Insert(name##_t* tree, point_t point, payload_t payload)
+//   name##Node_t* name##Search(name##_t* tree, point_t point, trace_t* trace)
+//   payload_t* name##Find(name##Node_t* leaf, int id)
+//   void name##Range(name##_t* tree, span_t* range, name##Results_t* results)
+//   void name##Free(name##_t* tree)
+#define GENERIC_TREE_DEFINE(name, geometry, children, payload_t, payloadID, payloadCompare, payloadFree) \
+\
+typedef struct name##Node { \
+    geometry##Span_t span;  /* span of node */ \
+    geometry##Point_t point;  /* point of a leaf holding payloads */ \
+    struct name##Node* childNodes;  /* `children` next to each other in code order, NULL for a leaf */ \
+    payload_t* payloads;  /* payloads at `point` sorted by payloadCompare */ \
+    int n; \
+    int size; \
+    int count;  /* number of payloads stored in the subtree of the node */ \
+    char code;  /* child of its parent the node is, `children` for the root */ \
+} name##Node_t; \
+\
+typedef struct name { \
+    name##Node_t root; \
+} name##_t; \
+\
+/* payloads found by a range query, still owned by the tree */ \
+typedef struct name##Results { \
+    payload_t* A; \
+    int n; \
+    int size; \
+} name##Results_t; \
+\
+/* sets `node` up as an empty leaf spanning `span` coded `code` */ \
+static inline void name##NodeInit(name##Node_t* node, geometry##Span_t span, int code) { \
+    node->span = span; \
+    node->childNodes = NULL; \
+    node->payloads = NULL; \
+    node->n = 0; \
+    node->size = 0; \
+    node->count = 0; \
+    node->code = code; \
+} \
+\
+/* creates and returns an empty tree spanning `span` */ \
+static inline name##_t* name##Create(geometry##Span_t span) { \
+    name##_t* tree = malloc(sizeof(*tree)); \
+    assert(tree); \
+    name##NodeInit(&tree->root, span, children); \
+    return tree; \
+} \
+\
+/* inserts `payload` into leaf `node` keeping its payloads sorted, after equal ones */ \
+static inline void name##AddPayload(name##Node_t* node, payload_t payload) { \
+    if (node->n == node->size) { \
+        node->size = node->size > 0 ? 2 * node->size : GENERIC_INIT_SIZE; \
+        node->payloads = realloc(node->payloads, node->size * sizeof(*node->payloads)); \
+        assert(node->payloads); \
+    } \
+    int i; \
+    for (i = node->n - 1; i >= 0 && payloadCompare(payload, node->payloads[i]) < 0; i--) \
+        node->payloads[i + 1] = node->payloads[i]; \
+    node->payloads[i + 1] = payload; \
+    node->n++; \
+} \
+\
+/* returns a block of `children` empty leaves splitting `span` */ \
+static inline name##Node_t* name##Children(geometry##Span_t* span) { \
+    name##Node_t* childNodes = malloc(children * sizeof(*childNodes)); \
+    assert(childNodes); \
+    for (int code = 0; code < children; code++) \
+        name##NodeInit(&childNodes[code], geometry##ChildSpan(span, code), code); \
+    return childNodes; \
+} \
+\
+/* splits leaf `node` into its children, moving its point and payloads to one of them */ \
+static inline void name##Split(name##Node_t* node) { \
+    name##Node_t* childNodes = name##Children(&node->span); \
+\
+    name##Node_t* child = &childNodes[geometry##Child(&node->span, &node->point)]; \
+    child->point = node->point; \
+    child->payloads = node->payloads; \
+    child->n = child->count = node->n; \
+    child->size = node->size; \
+\
+    node->payloads = NULL; \
+    node->n = node->size = 0; \
+    node->childNodes = childNodes; \
+} \
+\
+/* adds new roots above the root of `tree` until `point` is within the root, */ \
+/* the old root becoming a child of the new one as qTreeGrow does */ \
+static inline void name##Grow(name##_t* tree, geometry##Point_t* point) { \
+    while (!geometry##Contains(&tree->root.span, point)) { \
+        int code; \
+        geometry##Span_t span = geometry##Grow(&tree->root.span, point, &code); \
+        name##Node_t* childNodes = name##Children(&span); \
+\
+        childNodes[code] = tree->root; \
+        childNodes[code].code = code; \
+\
+        int count = tree->root.count; \
+        name##NodeInit(&tree->root, span, children); \
+        tree->root.childNodes = childNodes; \
+        tree->root.count = count; \
+    } \
+} \
+\
+/* inserts `payload` at `point` into `tree` as qTreeInsert does, */ \
+/* growing `tree` first if `point` is outside of its root */ \
+static inline void name##Insert(name##_t* tree, geometry##Point_t point, payload_t payload) { \
+    if (!geometry##Contains(&tree->root.span, &point)) \
+        name##Grow(tree, &point); \
+\
+    name##Node_t* node = &tree->root; \
+    while (1) { \
+        node->count++; \
+\
+        if (node->childNodes == NULL) { \
+            if (node->n == 0) { \
+                node->point = point; \
+                name##AddPayload(node, payload); \
+                return; \
+            } \
+            if (geometry##Same(&node->point, &point)) { \
+                name##AddPayload(node, payload); \
+                return; \
+            } \
+            name##Split(node); \
+        } \
+\
+        node = &node->childNodes[geometry##Child(&node->span, &point)]; \
+    } \
+} \
+\
+/* searches `tree` for `point` as qTreeSearch does, appending the codes of the */ \
+/* children accessed to reach `point` to `trace`, which may be NULL */ \
+/* returns the leaf holding `point`, NULL if `point` is not in `tree` */ \
+static inline name##Node_t* name##Search(name##_t* tree, geometry##Point_t point, trace_t* trace) { \
+    name##Node_t* node = &tree->root; \
+\
+    while (node->childNodes != NULL) { \
+        if (!geometry##Contains(&node->span, &point)) \
+            return NULL; \
+        if (node->code != children) \
+            traceAppend(trace, node->code); \
+\
+        int code = geometry##Child(&node->span, &point); \
+        if (code == -1) \
+            return NULL; \
+        node = &node->childNodes[code]; \
+    } \
+\
+    if (node->n == 0 || !geometry##Same(&node->point, &point)) \
+        return NULL; \
+\
+    traceAppend(trace, node->code); \
+    return node; \
+} \
+\
+/* searches the payloads of `leaf` for the one with `id` */ \
+/* returns a pointer to it, NULL if not found */ \
+static inline payload_t* name##Find(name##Node_t* leaf, int id) { \
+    int low = 0, high = leaf->n - 1; \
+    while (low <= high) { \
+        int middle = (low + high) / 2; \
+        int middleID = payloadID(leaf->payloads[middle]); \
+        if (middleID == id) \
+            return &leaf->payloads[middle]; \
+        if (middleID < id) \
+            low = middle + 1; \
+        else \
+            high = middle - 1; \
+    } \
+    return NULL; \
+} \
+\
+/* appends `payload` to `results` */ \
+static inline void name##ResultsAppend(name##Results_t* results, payload_t payload) { \
+    if (results->n == results->size) { \
+        results->size = results->size > 0 ? 2 * results->size : GENERIC_INIT_SIZE; \
+        results->A = realloc(results->A, results->size * sizeof(*results->A)); \
+        assert(results->A); \
+    } \
+    results->A[results->n++] = payload; \
+} \
+\
+/* recursively appends every payload below `node` at a point within `range` to `results` */ \
+static inline void name##RangeNode(name##Node_t* node, geometry##Span_t* range, name##Results_t* results) { \
+    if (node->count == 0 || !geometry##Overlaps(&node->span, range)) \
+        return; \
+\
+    if (node->childNodes == NULL) { \
+        if (geometry##Holds(range, &node->point)) { \
+            for (int i = 0; i < node->n; i++) \
+                name##ResultsAppend(results, node->payloads[i]); \
+        } \
+        return; \
+    } \
+    for (int code = 0; code < children; code++) \
+        name##RangeNode(&node->childNodes[code], range, results); \
+} \
+\
+/* appends every payload of `tree` at a point within `range`, borders included, */ \
+/* to `results`, a payload stored at two points within `range` is appended twice */ \
+static inline void name##Range(name##_t* tree, geometry##Span_t* range, name##Results_t* results) { \
+    name##RangeNode(&tree->root, range, results); \
+} \
+\
+/* recursively frees the payloads and children of `node` */ \
+static inline void name##FreeNode(name##Node_t* node) { \
+    for (int i = 0; i < node->n; i++) \
+        payloadFree(node->payloads[i]); \
+    free(node->payloads); \
+\
+    if (node->childNodes != NULL) { \
+        for (int code = 0; code < children; code++) \
+            name##FreeNode(&node->childNodes[code]); \
+        free(node->childNodes); \
+    } \
+} \
+\
+/* frees `tree` and every payload in it */ \
+static inline void name##Free(name##_t* tree) { \
+    name##FreeNode(&tree->root); \
+    free(tree); \
+}
+
+// defines a PR quadtree `name##_t` as GENERIC_TREE_DEFINE does, spanning a
+// rectangle_t and storing payloads at a point_t
+#define GENERIC_QTREE_DEFINE(name, payload_t, payloadID, payloadCompare, payloadFree) \
+    GENERIC_TREE_DEFINE(name, quad, QUADRANTS, payload_t, payloadID, payloadCompare, payloadFree)
+
+#endif
@@ -0,0 +1,300 @@
+/* Project: PR QuadTrees
+* graph.c :
+*            = implementation of the module graph of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "graph.h"
+#include "quadtree.h"
+#include "array.h"
+#include "join.h"
+#include "store.h"
+
+// edge between two vertices of a graph being built
+typedef struct graphEdge {
+    int from;
+    int to;
+} graphEdge_t;
+
+// edges of a graph being built
+typedef struct graphBuild {
+    footpathGraph_t* graph;
+    graphEdge_t* edges;
+    int n;
+    int size;
+} graphBuild_t;
+
+// vertex waiting in the queue of a shortest path search, with its distance so far
+typedef struct graphQueued {
+    double distance;
+    int vertex;
+} graphQueued_t;
+
+// compares footpaths pointed to by `a` and `b` by id, for qsort
+static int graphCmpFootpath(const void* a, const void* b) {
+    return footpathCmpID(*(footpath_t**)a, *(footpath_t**)b);
+}
+
+// compares edges `a` and `b` by their vertices, for qsort
+static int graphCmpEdge(const void* a, const void* b) {
+    const graphEdge_t* x = a;
+    const graphEdge_t* y = b;
+    if (x->from != y->from)
+        return x->from < y->from ? -1 : 1;
+    return (x->to > y->to) - (x->to < y->to);
+}
+
+// adds the edges between vertices `a` and `b` both ways to `build`
+static void graphAddEdge(graphBuild_t* build, int a, int b) {
+    if (a == b)
+        return;
+
+    if (build->n + 2 > build->size) {
+        build->size *= 2;
+        build->edges = realloc(build->edges, build->size * sizeof(*build->edges));
+        assert(build->edges);
+    }
+    build->edges[build->n++] = (graphEdge_t){a, b};
+    build->edges[build->n++] = (graphEdge_t){b, a};
+}
+
+// joins every footpath of leaf `a` with every footpath of leaf `b` in `build`
+static void graphJoinLeaves(graphBuild_t* build, qTreeNode_t* a, qTreeNode_t* b) {
+    for (int i = 0; i < a->footpaths->n; i++) {
+        int from = footpathGraphVertex(build->graph, footpathGetID(a->footpaths->A[i]));
+        for (int j = a == b ? i + 1 : 0; j < b->footpaths->n; j++)
+            graphAddEdge(build, from, footpathGraphVertex(build->graph, footpathGetID(b->footpaths->A[j])));
+    }
+}
+
+// joins the footpaths of leaves `a` and `b`, points close enough to be joined
+static void graphJoinCallback(qTreeNode_t* a, qTreeNode_t* b, double distance, void* data) {
+    graphJoinLeaves(data, a, b);
+}
+
+// builds the graph of the footpaths of finalized `qTree` in one walk, joining
+// footpaths sharing a point, and also footpaths with points at most `tolerance`
+// metres apart if `tolerance` is above 0, found by joining `qTree` with itself
+// the footpaths are still owned by `qTree`, which has to outlive the graph
+footpathGraph_t* footpathGraphBuild(qTree_t* qTree, double tolerance) {
+    // leaves are read from the leaf arrays of a finalized tree
+    assert(qTree->footpathPool != NULL);
+
+    footpathGraph_t* graph = malloc(sizeof(*graph));
+    assert(graph);
+
+    // both copies of a footpath are in the pool, only the first becomes a vertex
+    graph->footpaths = malloc((qTree->nFootpaths > 0 ? qTree->nFootpaths : 1) * sizeof(*graph->footpaths));
+    assert(graph->footpaths);
+    memcpy(graph->footpaths, qTree->footpathPool, qTree->nFootpaths * sizeof(*graph->footpaths));
+    qsort(graph->footpaths, qTree->nFootpaths, sizeof(*graph->footpaths), graphCmpFootpath);
+
+    graph->nVertices = 0;
+    for (int i = 0; i < qTree->nFootpaths; i++) {
+        if (graph->nVertices == 0 ||
+            footpathGetID(graph->footpaths[i]) != footpathGetID(graph->footpaths[graph->nVertices - 1]))
+            graph->footpaths[graph->nVertices++] = graph->footpaths[i];
+    }
+
+    graphBuild_t build;
+    build.graph = graph;
+    build.size = GRAPH_INIT_SIZE;
+    build.edges = malloc(build.size * sizeof(*build.edges));
+    assert(build.edges);
+    build.n = 0;
+
+    // footpaths meeting at a point share its leaf
+    for (int i = 0; i < qTree->nLeaves; i++) {
+        array_t* footpaths = &qTree->leafArrays[i];
+        for (int a = 0; a < footpaths->n; a++) {
+            int from = footpathGraphVertex(graph, footpathGetID(footpaths->A[a]));
+            for (int b = a + 1; b < footpaths->n; b++)
+                graphAddEdge(&build, from, footpathGraphVertex(graph, footpathGetID(footpaths->A[b])));
+        }
+    }
+
+    if (tolerance > 0)
+        qTreeJoin(qTree, qTree, tolerance, graphJoinCallback, &build);
+
+    // a pair of footpaths may meet at both ends or be joined more than once
+    qsort(build.edges, build.n, sizeof(*build.edges), graphCmpEdge);
+
+    graph->offsets = calloc(graph->nVertices + 1, sizeof(*graph->offsets));
+    graph->targets = malloc((build.n > 0 ? build.n : 1) * sizeof(*graph->targets));
+    assert(graph->offsets && graph->targets);
+    graph->nEdges = 0;
+
+    for (int i = 0; i < build.n; i++) {
+        if (i > 0 && graphCmpEdge(&build.edges[i], &build.edges[i - 1]) == 0)
+            continue;
+        graph->targets[graph->nEdges++] = build.edges[i].to;
+        graph->offsets[build.edges[i].from + 1]++;
+    }
+    for (int v = 0; v < graph->nVertices; v++)
+        graph->offsets[v + 1] += graph->offsets[v];
+
+    graph->targets = realloc(graph->targets, (graph->nEdges > 0 ? graph->nEdges : 1) * sizeof(*graph->targets));
+    assert(graph->targets);
+    free(build.edges);
+
+    return graph;
+}
+
+// returns the vertex of the footpath with `footpathID` in `graph`, -1 if there is none
+int footpathGraphVertex(footpathGraph_t* graph, int footpathID) {
+    int low = 0, high = graph->nVertices - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        int middleID = footpathGetID(graph->footpaths[middle]);
+        if (middleID == footpathID)
+            return middle;
+        if (middleID < footpathID)
+            low = middle + 1;
+        else
+            high = middle - 1;
+    }
+    return -1;
+}
+
+// returns the distance of the footpath of `vertex` of `graph`, read from its store
+static double graphLength(footpathGraph_t* graph, int vertex) {
+    footpath_t* footpath = graph->footpaths[vertex];
+    return footpath->store->distance[footpath->row];
+}
+
+// pushes `vertex` at `distance` onto min heap `queue` of `n` vertices
+static void graphPush(graphQueued_t* queue, int* n, int vertex, double distance) {
+    int i = (*n)++;
+    for (; i > 0 && queue[(i - 1) / 2].distance > distance; i = (i - 1) / 2)
+        queue[i] = queue[(i - 1) / 2];
+    queue[i] = (graphQueued_t){distance, vertex};
+}
+
+// removes and returns the nearest vertex from min heap `queue` of `n` vertices
+static graphQueued_t graphPop(graphQueued_t* queue, int* n) {
+    graphQueued_t top = queue[0];
+    graphQueued_t last = queue[--(*n)];
+
+    int i = 0;
+    while (2 * i + 1 < *n) {
+        int child = 2 * i + 1;
+        if (child + 1 < *n && queue[child + 1].distance < queue[child].distance)
+            child++;
+        if (queue[child].distance >= last.distance)
+            break;
+        queue[i] = queue[child];
+        i = child;
+    }
+    queue[i] = last;
+    return top;
+}
+
+// finds the shortest walk from vertex `from` to vertex `to` of `graph` by the
+// distance of every footpath walked along, both ends included, and appends its
+// footpaths in order to `path`
+// returns the length of the walk, -1 if `to` can't be reached from `from`
+double footpathGraphShortestPath(footpathGraph_t* graph, int from, int to, array_t* path) {
+    assert(from >= 0 && from < graph->nVertices && to >= 0 && to < graph->nVertices);
+
+    double* distances = malloc(graph->nVertices * sizeof(*distances));
+    int* previous = malloc(graph->nVertices * sizeof(*previous));
+    // a vertex is queued at most once per edge into it, and once as the source
+    graphQueued_t* queue = malloc((graph->nEdges + 1) * sizeof(*queue));
+    assert(distances && previous && queue);
+
+    for (int v = 0; v < graph->nVertices; v++) {
+        distances[v] = INFINITY;
+        previous[v] = -1;
+    }
+
+    int n = 0;
+    distances[from] = graphLength(graph, from);
+    graphPush(queue, &n, from, distances[from]);
+
+    while (n > 0) {
+        graphQueued_t nearest = graphPop(queue, &n);
+        int u = nearest.vertex;
+        if (nearest.distance > distances[u])
+            continue;
+        if (u == to)
+            break;
+
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            double distance = distances[u] + graphLength(graph, v);
+            if (distance < distances[v]) {
+                distances[v] = distance;
+                previous[v] = u;
+                graphPush(queue, &n, v, distance);
+            }
+        }
+    }
+
+    double length = distances[to];
+    if (length != INFINITY) {
+        // walking back from `to` and reversing the footpaths appended
+        int first = path->n;
+        for (int v = to; v != -1; v = previous[v])
+            arrayAppend(path, graph->footpaths[v]);
+        for (int i = first, j = path->n - 1; i < j; i++, j--) {
+            footpath_t* footpath = path->A[i];
+            path->A[i] = path->A[j];
+            path->A[j] = footpath;
+        }
+    }
+
+    free(distances);
+    free(previous);
+    free(queue);
+    return length != INFINITY ? length : -1;
+}
+
+// labels every vertex of `graph` with its connected component in `components`,
+// numbered from 0 in order of their lowest vertex, returns the number of components
+int footpathGraphComponents(footpathGraph_t* graph, int* components) {
+    int* stack = malloc((graph->nVertices > 0 ? graph->nVertices : 1) * sizeof(*stack));
+    assert(stack);
+
+    for (int v = 0; v < graph->nVertices; v++)
+        components[v] = -1;
+
+    int nComponents = 0;
+    for (int v = 0; v < graph->nVertices; v++) {
+        if (components[v] != -1)
+            continue;
+
+        // every vertex is pushed once, when it is labelled
+        int n = 0;
+        stack[n++] = v;
+        components[v] = nComponents;
+        while (n > 0) {
+            int u = stack[--n];
+            for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+                if (components[graph->targets[e]] == -1) {
+                    components[graph->targets[e]] = nComponents;
+                    stack[n++] = graph->targets[e];
+                }
+            }
+        }
+        nComponents++;
+    }
+
+    free(stack);
+    return nComponents;
+}
+
+// free allocated memory used by `graph`
+void footpathGraphFree(footpathGraph_t* graph) {
+    free(graph->footpaths);
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph);
+}
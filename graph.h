@@ -0,0 +1,51 @@
+/* Project: PR QuadTrees
+* graph.h :
+*            = interface of the module graph of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _GRAPH_H_
+#define _GRAPH_H_
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+
+// initial number of edges a graph being built has room for
+#define GRAPH_INIT_SIZE 256
+
+// footpaths of a qTree as vertices, joined by an edge when they meet at a point
+// edges are stored in compressed sparse rows, both ways
+typedef struct footpathGraph {
+    int nVertices;
+    footpath_t** footpaths;  // footpath of every vertex, sorted by footpathID
+    int* offsets;  // edges of vertex v are targets[offsets[v]] up to targets[offsets[v + 1]]
+    int* targets;  // vertices at the other end of every edge
+    int nEdges;
+} footpathGraph_t;
+
+// builds the graph of the footpaths of finalized `qTree` in one walk, joining
+// footpaths sharing a point, and also footpaths with points at most `tolerance`
+// metres apart if `tolerance` is above 0, found by joining `qTree` with itself
+// the footpaths are still owned by `qTree`, which has to outlive the graph
+footpathGraph_t* footpathGraphBuild(qTree_t* qTree, double tolerance);
+
+// returns the vertex of the footpath with `footpathID` in `graph`, -1 if there is none
+int footpathGraphVertex(footpathGraph_t* graph, int footpathID);
+
+// finds the shortest walk from vertex `from` to vertex `to` of `graph` by the
+// distance of every footpath walked along, both ends included, and appends its
+// footpaths in order to `path`
+// returns the length of the walk, -1 if `to` can't be reached from `from`
+double footpathGraphShortestPath(footpathGraph_t* graph, int from, int to, array_t* path);
+
+// labels every vertex of `graph` with its connected component in `components`,
+// numbered from 0 in order of their lowest vertex, returns the number of components
+int footpathGraphComponents(footpathGraph_t* graph, int* components);
+
+// free allocated memory used by `graph`
+void footpathGraphFree(footpathGraph_t* graph);
+
+#endif
@@ -0,0 +1,255 @@
+/* Project: PR QuadTrees
+* join.c :
+*            = implementation of the module join of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+
+#include "join.h"
+#include "quadtree.h"
+#include "array.h"
+
+// state shared by every node pair of a join
+typedef struct join {
+    double distance;  // in metres
+    int self;  // whether both trees are the same tree
+    joinCallback_t callback;
+    void* data;
+    long nPairs;
+} join_t;
+
+// node of the frontier of a nearest neighbour search with its distance from the query
+// in metres, exact for a leaf holding a point and a lower bound for any other node
+typedef struct nearestNode {
+    double distance;
+    qTreeNode_t* node;
+} nearestNode_t;
+
+// returns the metres spanned by a degree of longitude at `latitude`, degrees of
+// longitude shrink away from the equator and vanish at the poles
+static double joinXScale(long double latitude) {
+    if (fabsl(latitude) >= 90)
+        return 0;
+    return METRES_PER_DEGREE * cos(latitude * M_PI / 180);
+}
+
+// returns the distance in metres spanned by `dx` degrees of longitude and `dy` of
+// latitude, measured on a flat projection with `xScale` metres per degree of longitude
+static double joinMetres(double xScale, long double dx, long double dy) {
+    double x = dx * xScale;
+    double y = dy * METRES_PER_DEGREE;
+    return sqrt(x * x + y * y);
+}
+
+// returns a lower bound of the distance in metres between any points of rectangles `a` and `b`
+// degrees of longitude are measured at the latitude of either furthest from the equator,
+// where they are shortest, so the bound holds wherever the points are
+static double joinRectangleDistance(rectangle_t* a, rectangle_t* b) {
+    long double dx = 0, dy = 0;
+    if (a->topRightX < b->botLeftX)
+        dx = b->botLeftX - a->topRightX;
+    else if (b->topRightX < a->botLeftX)
+        dx = a->botLeftX - b->topRightX;
+
+    if (a->topRightY < b->botLeftY)
+        dy = b->botLeftY - a->topRightY;
+    else if (b->topRightY < a->botLeftY)
+        dy = a->botLeftY - b->topRightY;
+
+    long double latitude = fmaxl(fmaxl(fabsl(a->botLeftY), fabsl(a->topRightY)),
+                                fmaxl(fabsl(b->botLeftY), fabsl(b->topRightY)));
+    return joinMetres(joinXScale(latitude), dx, dy);
+}
+
+// returns the distance in metres between points `a` and `b`, measured on a flat
+// projection at their middle latitude so it only depends on the two points
+static double joinPointDistance(point_t* a, point_t* b) {
+    return joinMetres(joinXScale((a->y + b->y) / 2), fabs(a->x - b->x), fabs(a->y - b->y));
+}
+
+// returns the area of `rectangle` in square degrees
+static long double joinArea(rectangle_t* rectangle) {
+    return (rectangle->topRightX - rectangle->botLeftX) * (rectangle->topRightY - rectangle->botLeftY);
+}
+
+// recursively reports every pair of points below `a` and `b` within the join distance
+static void joinNodes(join_t* join, qTreeNode_t* a, qTreeNode_t* b) {
+    if (a->count == 0 || b->count == 0)
+        return;
+
+    if (joinRectangleDistance(a->rectangle, b->rectangle) > join->distance)
+        return;
+
+    // a node paired with itself only pairs its children once each way,
+    // so every pair of distinct points of a self join is reported once
+    if (join->self && a == b) {
+        if (a->NW == NULL)
+            return;
+
+        for (int i = 0; i < 4; i++) {
+            for (int j = i; j < 4; j++)
+                joinNodes(join, getQuadrant(a, i), getQuadrant(a, j));
+        }
+        return;
+    }
+
+    if (a->NW == NULL && b->NW == NULL) {
+        double distance = joinPointDistance(a->point, b->point);
+        if (distance <= join->distance) {
+            join->callback(a, b, distance, join->data);
+            join->nPairs++;
+        }
+        return;
+    }
+
+    // descending into the larger node keeps both sides of a pair similar in size
+    if (b->NW == NULL || (a->NW != NULL && joinArea(a->rectangle) >= joinArea(b->rectangle))) {
+        for (int i = 0; i < 4; i++)
+            joinNodes(join, getQuadrant(a, i), b);
+    } else {
+        for (int i = 0; i < 4; i++)
+            joinNodes(join, a, getQuadrant(b, i));
+    }
+}
+
+// calls `callback` with `data` for every pair of points of `treeA` and `treeB`
+// at most `distance` metres apart by walking both trees at once, skipping
+// pairs of nodes whose rectangles are further apart than `distance`
+// the distance of a pair is measured at the middle latitude of its two points,
+// so pairs don't depend on the spans of the trees
+// if `treeA` is `treeB` every pair of distinct points is reported once
+// returns the number of pairs reported
+long qTreeJoin(qTree_t* treeA, qTree_t* treeB, double distance,
+                joinCallback_t callback, void* data) {
+    join_t join;
+    join.distance = distance;
+    join.self = treeA == treeB;
+    join.callback = callback;
+    join.data = data;
+    join.nPairs = 0;
+
+    joinNodes(&join, treeA->root, treeB->root);
+    return join.nPairs;
+}
+
+// recursively appends footpaths below `node` with a point at most `distance`
+// metres from `point` to `results`, `span` is the rectangle of `point`
+static void radiusNode(qTreeNode_t* node, point_t* point, rectangle_t* span, double distance,
+                        array_t* results) {
+    if (node->count == 0 || joinRectangleDistance(node->rectangle, span) > distance)
+        return;
+
+    if (node->point != NULL) {
+        if (joinPointDistance(node->point, point) > distance)
+            return;
+        for (int i = 0; i < node->footpaths->n; i++) {
+            // footpaths with both points in range are appended once
+            if (arrayBinarySearch(results, footpathGetID(node->footpaths->A[i])) == NULL)
+                insertFootpathInArray(results, node->footpaths->A[i]);
+        }
+        return;
+    }
+
+    for (int quadrant = 0; node->NW != NULL && quadrant < 4; quadrant++)
+        radiusNode(getQuadrant(node, quadrant), point, span, distance, results);
+}
+
+// appends every footpath of `qTree` with a point at most `distance` metres from `point`
+// to `results` once, keeping `results` sorted by footpathID, skipping nodes whose
+// rectangles are further from `point` than `distance`
+array_t* qTreeRadius(qTree_t* qTree, point_t* point, double distance, array_t* results) {
+    rectangle_t span = {point->x, point->y, point->x, point->y};
+    radiusNode(qTree->root, point, &span, distance, results);
+    return results;
+}
+
+// pushes `node` `distance` metres away onto min heap `frontier` of `n` nodes with room for `size`
+static void nearestPush(nearestNode_t** frontier, int* n, int* size, qTreeNode_t* node,
+                        double distance) {
+    if (*n == *size) {
+        *size *= 2;
+        *frontier = realloc(*frontier, *size * sizeof(**frontier));
+        assert(*frontier);
+    }
+
+    nearestNode_t* heap = *frontier;
+    int i = (*n)++;
+    for (; i > 0 && heap[(i - 1) / 2].distance > distance; i = (i - 1) / 2)
+        heap[i] = heap[(i - 1) / 2];
+    heap[i] = (nearestNode_t){distance, node};
+}
+
+// removes and returns the nearest node from min heap `frontier` of `n` nodes
+static nearestNode_t nearestPop(nearestNode_t* frontier, int* n) {
+    nearestNode_t top = frontier[0];
+    nearestNode_t last = frontier[--(*n)];
+
+    int i = 0;
+    while (2 * i + 1 < *n) {
+        int child = 2 * i + 1;
+        if (child + 1 < *n && frontier[child + 1].distance < frontier[child].distance)
+            child++;
+        if (frontier[child].distance >= last.distance)
+            break;
+        frontier[i] = frontier[child];
+        i = child;
+    }
+    frontier[i] = last;
+    return top;
+}
+
+// returns the distance in metres of `node` from `point`, `span` is the rectangle of `point`
+// exact for a leaf holding a point, a lower bound for any other node
+static double nearestDistance(qTreeNode_t* node, point_t* point, rectangle_t* span) {
+    if (node->point != NULL)
+        return joinPointDistance(node->point, point);
+    return joinRectangleDistance(node->rectangle, span);
+}
+
+// appends the `k` footpaths of `qTree` nearest to `point` by their nearer point to
+// `results`, nearest first and footpaths at the same point by footpathID
+// nodes are visited nearest first, stopping once `k` footpaths are found
+array_t* qTreeNearest(qTree_t* qTree, point_t* point, int k, array_t* results) {
+    rectangle_t span = {point->x, point->y, point->x, point->y};
+    int size = NEAREST_INIT_SIZE, n = 0, found = 0;
+    nearestNode_t* frontier = malloc(size * sizeof(*frontier));
+    assert(frontier);
+
+    // leaves come off the frontier in the order of their points, so a footpath
+    // is first found at its nearer point
+    array_t* footpathVisited = arrayCreate();
+    if (qTree->root->count > 0)
+        nearestPush(&frontier, &n, &size, qTree->root, nearestDistance(qTree->root, point, &span));
+
+    while (n > 0 && found < k) {
+        qTreeNode_t* node = nearestPop(frontier, &n).node;
+
+        if (node->point != NULL) {
+            for (int i = 0; i < node->footpaths->n && found < k; i++) {
+                footpath_t* footpath = node->footpaths->A[i];
+                if (arrayBinarySearch(footpathVisited, footpathGetID(footpath)) == NULL) {
+                    insertFootpathInArray(footpathVisited, footpath);
+                    arrayAppend(results, footpath);
+                    found++;
+                }
+            }
+            continue;
+        }
+
+        for (int quadrant = 0; node->NW != NULL && quadrant < 4; quadrant++) {
+            qTreeNode_t* child = getQuadrant(node, quadrant);
+            if (child->count > 0)
+                nearestPush(&frontier, &n, &size, child, nearestDistance(child, point, &span));
+        }
+    }
+
+    arrayFreeShallow(footpathVisited);
+    free(frontier);
+    return results;
+}
@@ -0,0 +1,45 @@
+/* Project: PR QuadTrees
+* join.h :
+*            = interface of the module join of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _JOIN_H_
+#define _JOIN_H_
+
+#include "quadtree.h"
+#include "array.h"
+
+// metres spanned by a degree of latitude, and of longitude at the equator
+#define METRES_PER_DEGREE 111320.0
+
+// initial number of nodes the frontier of a nearest neighbour search has room for
+#define NEAREST_INIT_SIZE 64
+
+// called by qTreeJoin for every pair of leaves `a` and `b` whose points are
+// at most the join distance apart, `distance` is in metres
+typedef void (*joinCallback_t)(qTreeNode_t* a, qTreeNode_t* b, double distance, void* data);
+
+// calls `callback` with `data` for every pair of points of `treeA` and `treeB`
+// at most `distance` metres apart by walking both trees at once, skipping
+// pairs of nodes whose rectangles are further apart than `distance`
+// the distance of a pair is measured at the middle latitude of its two points,
+// so pairs don't depend on the spans of the trees
+// if `treeA` is `treeB` every pair of distinct points is reported once
+// returns the number of pairs reported
+long qTreeJoin(qTree_t* treeA, qTree_t* treeB, double distance,
+                joinCallback_t callback, void* data);
+
+// appends every footpath of `qTree` with a point at most `distance` metres from `point`
+// to `results` once, keeping `results` sorted by footpathID, skipping nodes whose
+// rectangles are further from `point` than `distance`
+array_t* qTreeRadius(qTree_t* qTree, point_t* point, double distance, array_t* results);
+
+// appends the `k` footpaths of `qTree` nearest to `point` by their nearer point to
+// `results`, nearest first and footpaths at the same point by footpathID
+// nodes are visited nearest first, stopping once `k` footpaths are found
+array_t* qTreeNearest(qTree_t* qTree, point_t* point, int k, array_t* results);
+
+#endif
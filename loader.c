@@ -0,0 +1,199 @@
+/* Project: PR QuadTrees
+* loader.c :
+*            = implementation of the module loader of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* --------------------------------------------------------------
+* The csv is memory mapped and split into one chunk per thread.
+* A chunk can only start after a newline outside quotation marks,
+* so the workers first count the quotation marks in their raw chunk,
+* which tells every worker whether its chunk starts inside quotes,
+* then move the start of their chunk to the next record and parse it.
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "loader.h"
+#include "data.h"
+#include "array.h"
+#include "store.h"
+
+// returns the number of worker threads footpathLoad should use on this machine
+int loaderThreads() {
+    long nThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    return nThreads > 0 ? nThreads : 1;
+}
+
+// counts the quotation marks in the raw span of the chunk `arg`
+static void* loaderCountQuotes(void* arg) {
+    loaderChunk_t* chunk = arg;
+    int quotes = 0;
+
+    for (char* c = chunk->begin; (c = memchr(c, '\"', chunk->end - c)) != NULL; c++)
+        quotes++;
+
+    chunk->quotes = quotes;
+    return NULL;
+}
+
+// returns the start of the first record at or after `c`, given whether
+// `c` is `inQuotes`, or `end` if no record starts before `end`
+static char* loaderAlign(char* c, char* end, int inQuotes) {
+    for (; c < end; c++) {
+        if (*c == '\"')
+            inQuotes = !inQuotes;
+        else if (*c == '\n' && !inQuotes)
+            return c + 1;
+    }
+    return end;
+}
+
+// parses the records starting in the chunk `arg`, which are the records
+// from its aligned start to the aligned start of the next chunk
+static void* loaderParse(void* arg) {
+    loaderChunk_t* chunk = arg;
+    char* c = chunk->begin;
+    char* end = chunk->end;
+
+    // buffer for a row as getline would read it, footpathRead modifies it
+    size_t size = MAX_CHARS + 1;
+    char* line = malloc(size);
+    assert(line);
+
+    while (c < end) {
+        char* newline = memchr(c, '\n', end - c);
+        size_t len = newline ? newline - c + 1 : end - c;
+
+        // skipping empty rows
+        if (len > 1 || *c != '\n') {
+            if (len + 1 > size) {
+                size = len + 1;
+                line = realloc(line, size);
+                assert(line);
+            }
+            memcpy(line, c, len);
+            line[len] = '\0';
+
+            if (chunk->nRecords == chunk->size) {
+                chunk->size = chunk->size ? 2 * chunk->size : INIT_SIZE;
+                chunk->records = realloc(chunk->records, chunk->size * sizeof(*chunk->records));
+                assert(chunk->records);
+            }
+            chunk->records[chunk->nRecords++] = footpathRead(line);
+        }
+        c += len;
+    }
+
+    free(line);
+    return NULL;
+}
+
+// runs `work` on every chunk in `chunks` on its own thread and waits for them
+static void loaderRun(loaderChunk_t* chunks, int nChunks, void* (*work)(void*)) {
+    pthread_t* threads = malloc(nChunks * sizeof(*threads));
+    assert(threads);
+
+    // chunk 0 is worked on by the calling thread, as is any chunk no thread
+    // could be started for
+    char* started = malloc(nChunks);
+    assert(started);
+    for (int i = 1; i < nChunks; i++)
+        started[i] = pthread_create(&threads[i], NULL, work, &chunks[i]) == 0;
+    work(&chunks[0]);
+    for (int i = 1; i < nChunks; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        else
+            work(&chunks[i]);
+    }
+
+    free(started);
+    free(threads);
+}
+
+// reads every footpath of csv `fileName` into `store` using `nThreads` worker threads
+// returns the footpaths in the order of the rows of `fileName`
+array_t* footpathLoad(char* fileName, int nThreads, footpathStore_t* store) {
+    int fd = open(fileName, O_RDONLY);
+    assert(fd != -1);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        fprintf(stderr, "cannot read the size of %s\n", fileName);
+        exit(EXIT_FAILURE);
+    }
+
+    array_t* footpaths = arrayCreate();
+    if (st.st_size == 0) {
+        close(fd);
+        return footpaths;
+    }
+
+    char* file = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    assert(file != MAP_FAILED);
+    close(fd);
+
+    char* end = file + st.st_size;
+
+    // skip the header line
+    char* start = memchr(file, '\n', st.st_size);
+    start = start ? start + 1 : end;
+
+    // not worth a thread for less than MIN_CHUNK_SIZE bytes
+    size_t size = end - start;
+    if (nThreads > size / MIN_CHUNK_SIZE)
+        nThreads = size / MIN_CHUNK_SIZE;
+    if (nThreads < 1)
+        nThreads = 1;
+
+    loaderChunk_t* chunks = malloc(nThreads * sizeof(*chunks));
+    assert(chunks);
+    for (int i = 0; i < nThreads; i++) {
+        chunks[i].begin = start + size * i / nThreads;
+        chunks[i].end = start + size * (i + 1) / nThreads;
+        chunks[i].records = NULL;
+        chunks[i].nRecords = 0;
+        chunks[i].size = 0;
+    }
+
+    // quotation marks before a chunk decide if it starts inside quotes
+    loaderRun(chunks, nThreads, loaderCountQuotes);
+    int quotes = 0;
+    for (int i = 0; i < nThreads; i++) {
+        chunks[i].inQuotes = quotes % 2;
+        quotes += chunks[i].quotes;
+    }
+
+    // moving every chunk boundary to the start of the next record
+    for (int i = 1; i < nThreads; i++)
+        chunks[i].begin = loaderAlign(chunks[i].begin, end, chunks[i].inQuotes);
+    for (int i = 0; i < nThreads - 1; i++)
+        chunks[i].end = chunks[i + 1].begin;
+    chunks[nThreads - 1].end = end;
+
+    loaderRun(chunks, nThreads, loaderParse);
+
+    // adding the records of every chunk to `store` in row order
+    for (int i = 0; i < nThreads; i++) {
+        for (int j = 0; j < chunks[i].nRecords; j++) {
+            arrayAppend(footpaths, footpathStoreAdd(store, chunks[i].records[j]));
+            footpathRecordFree(chunks[i].records[j]);
+        }
+        free(chunks[i].records);
+    }
+
+    free(chunks);
+    munmap(file, st.st_size);
+
+    return footpaths;
+}
@@ -0,0 +1,39 @@
+/* Project: PR QuadTrees
+* loader.h :
+*            = interface of the module loader of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _LOADER_H_
+#define _LOADER_H_
+
+#include <stddef.h>
+
+#include "data.h"
+#include "array.h"
+#include "store.h"
+
+// smallest chunk of the csv worth parsing on its own thread
+#define MIN_CHUNK_SIZE (64 * 1024)
+
+// chunk of the csv parsed by one worker thread
+typedef struct loaderChunk {
+    char* begin;  // first byte of the chunk before it is aligned to a record
+    char* end;  // byte after the last byte of the chunk before it is aligned
+    int quotes;  // number of quotation marks in [begin, end)
+    int inQuotes;  // whether `begin` is inside quotation marks
+    footpathRecord_t** records;  // records parsed from the chunk in row order
+    int nRecords;
+    int size;  // records `records` can hold before growing
+} loaderChunk_t;
+
+// reads every footpath of csv `fileName` into `store` using `nThreads` worker threads
+// returns the footpaths in the order of the rows of `fileName`
+array_t* footpathLoad(char* fileName, int nThreads, footpathStore_t* store);
+
+// returns the number of worker threads footpathLoad should use on this machine
+int loaderThreads();
+
+#endif
@@ -0,0 +1,136 @@
+/* Project: PR QuadTrees
+* lod.c :
+*            = implementation of the module lod of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "lod.h"
+#include "data.h"
+#include "quadtree.h"
+
+// creates and returns empty level of detail results
+lodResults_t* lodResultsCreate() {
+    lodResults_t* results = malloc(sizeof(*results));
+    assert(results);
+
+    results->size = LOD_INIT_SIZE;
+    results->items = malloc(results->size * sizeof(*results->items));
+    assert(results->items);
+    results->n = 0;
+
+    return results;
+}
+
+// appends `footpath` standing in for `count` footpath points to `results`
+static void lodAppend(lodResults_t* results, footpath_t* footpath, int count) {
+    if (results->n == results->size) {
+        results->size *= 2;
+        results->items = realloc(results->items, results->size * sizeof(*results->items));
+        assert(results->items);
+    }
+    results->items[results->n].footpath = footpath;
+    results->items[results->n].count = count;
+    results->n++;
+}
+
+// returns whether `span` has any point in common with `range`, borders included
+static int lodOverlaps(rectangle_t* span, rectangle_t* range) {
+    return span->topRightX >= range->botLeftX && span->botLeftX <= range->topRightX &&
+        span->topRightY >= range->botLeftY && span->botLeftY <= range->topRightY;
+}
+
+// returns whether every point of `span` is within `range`, borders included
+static int lodContains(rectangle_t* range, rectangle_t* span) {
+    return span->botLeftX >= range->botLeftX && span->topRightX <= range->topRightX &&
+        span->botLeftY >= range->botLeftY && span->topRightY <= range->topRightY;
+}
+
+// recursively adds the footpath points below `node` within `range` to `count`
+// and keeps the leaf with the most of them within `range` in `fullest`
+static void lodClip(qTreeNode_t* node, rectangle_t* range, int* count, qTreeNode_t** fullest) {
+    if (node->count == 0 || !lodOverlaps(node->rectangle, range))
+        return;
+
+    if (node->point != NULL) {
+        if (inRectangleStage4(range, node->point)) {
+            *count += node->footpaths->n;
+            if (*fullest == NULL || node->footpaths->n > (*fullest)->footpaths->n)
+                *fullest = node;
+        }
+        return;
+    }
+
+    if (node->NW) {
+        lodClip(node->SW, range, count, fullest);
+        lodClip(node->NW, range, count, fullest);
+        lodClip(node->NE, range, count, fullest);
+        lodClip(node->SE, range, count, fullest);
+    }
+}
+
+// recursively appends items for the points below `node` within `range` to `results`
+static void lodNode(qTreeNode_t* node, rectangle_t* range, long double resolution,
+                    lodResults_t* results) {
+    rectangle_t* span = node->rectangle;
+
+    if (node->count == 0 || !lodOverlaps(span, range))
+        return;
+
+    // nodes this small are a single item at this level of detail
+    if (span->topRightX - span->botLeftX <= resolution && span->topRightY - span->botLeftY <= resolution) {
+        if (lodContains(range, span)) {
+            lodAppend(results, node->representative, node->count);
+            return;
+        }
+
+        // only the points within `range` of a node across its border are counted,
+        // stood in for by a footpath of the fullest leaf among them
+        int count = 0;
+        qTreeNode_t* fullest = NULL;
+        lodClip(node, range, &count, &fullest);
+        if (count > 0)
+            lodAppend(results, fullest->representative, count);
+        return;
+    }
+
+    if (node->point != NULL) {
+        if (inRectangleStage4(range, node->point))
+            lodAppend(results, node->representative, node->footpaths->n);
+        return;
+    }
+
+    if (node->NW) {
+        lodNode(node->SW, range, resolution, results);
+        lodNode(node->NW, range, resolution, results);
+        lodNode(node->NE, range, resolution, results);
+        lodNode(node->SE, range, resolution, results);
+    }
+}
+
+// searches a finalized `qTree` for points within `range`, not descending into nodes
+// no wider or taller than `resolution`, which are stood in for by their
+// representative footpath and the number of footpath points below them
+// a node across the border of `range` only counts its points within `range`,
+// stood in for by a footpath at one of them
+// every point found before reaching `resolution` is an item of its own
+// the number of items is bounded by the area of `range` over `resolution` squared
+lodResults_t* qTreeLodRange(qTree_t* qTree, rectangle_t* range, long double resolution,
+                        lodResults_t* results) {
+    // representatives are chosen when the tree is finalized
+    assert(qTree->footpathPool != NULL);
+
+    lodNode(qTree->root, range, resolution, results);
+    return results;
+}
+
+// free allocated memory used by `results`, footpaths belong to the tree
+void lodResultsFree(lodResults_t* results) {
+    free(results->items);
+    free(results);
+}
@@ -0,0 +1,46 @@
+/* Project: PR QuadTrees
+* lod.h :
+*            = interface of the module lod of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _LOD_H_
+#define _LOD_H_
+
+#include "data.h"
+#include "quadtree.h"
+
+#define LOD_INIT_SIZE 16  // initial number of items a level of detail result can hold
+
+// footpath standing in for `count` footpath points of a query at low detail
+typedef struct lodItem {
+    footpath_t* footpath;
+    int count;
+} lodItem_t;
+
+// items of a level of detail range query
+typedef struct lodResults {
+    lodItem_t* items;
+    int n;  // items in the results
+    int size;  // items the results can hold before growing
+} lodResults_t;
+
+// creates and returns empty level of detail results
+lodResults_t* lodResultsCreate();
+
+// searches a finalized `qTree` for points within `range`, not descending into nodes
+// no wider or taller than `resolution`, which are stood in for by their
+// representative footpath and the number of footpath points below them
+// a node across the border of `range` only counts its points within `range`,
+// stood in for by a footpath at one of them
+// every point found before reaching `resolution` is an item of its own
+// the number of items is bounded by the area of `range` over `resolution` squared
+lodResults_t* qTreeLodRange(qTree_t* qTree, rectangle_t* range, long double resolution,
+                        lodResults_t* results);
+
+// free allocated memory used by `results`, footpaths belong to the tree
+void lodResultsFree(lodResults_t* results);
+
+#endif
@@ -0,0 +1,117 @@
+/* Project: PR QuadTrees
+* octree.h :
+*            = interface of the module octree of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _OCTREE_H_
+#define _OCTREE_H_
+
+#include <math.h>
+#include <assert.h>
+
+#include "quadtree.h"
+#include "trace.h"
+#include "generic.h"
+
+// children of a node of a tree in space, the root is coded NO_OCTANT
+#define OCTANTS 8
+
+// struct to keep track of region spanned by node of an octree
+// the bottom left corner is also the lowest one
+typedef struct box3D {
+    long double botLeftX;
+    long double botLeftY;
+    long double botLeftZ;
+    long double topRightX;
+    long double topRightY;
+    long double topRightZ;
+} box_t;
+
+typedef struct dataPoint3D {
+    double x;
+    double y;
+    double z;
+} point3D_t;
+
+// octant geometry, the spans and points of a tree in space
+typedef box_t octSpan_t;
+typedef point3D_t octPoint_t;
+
+// returns the rectangle `box` covers in the plane
+static inline rectangle_t octPlane(box_t* box) {
+    return (rectangle_t){box->botLeftX, box->botLeftY, box->topRightX, box->topRightY};
+}
+
+// returns 0 to 7 for the octant of `box` `point` belongs in, the quadrant of
+// `point` in the plane as quadChild finds it, plus 4 if in the lower half
+// z is split as y is, the lower border belonging to the box and the upper one not
+// returns -1 if point doesn't belong in either octant
+static inline int octChild(box_t* box, point3D_t* point) {
+    rectangle_t plane = octPlane(box);
+    int quadrant = quadChild(&plane, &(point_t){point->x, point->y});
+    if (quadrant == -1 || point->z < box->botLeftZ || point->z >= box->topRightZ)
+        return -1;
+
+    long double middleZ = (box->botLeftZ + box->topRightZ) / 2;
+    return point->z < middleZ ? QUADRANTS + quadrant : quadrant;
+}
+
+// returns the span of `octant` of `box`
+static inline box_t octChildSpan(box_t* box, int octant) {
+    rectangle_t plane = octPlane(box);
+    rectangle_t quadrant = quadChildSpan(&plane, octant % QUADRANTS);
+    long double middleZ = (box->botLeftZ + box->topRightZ) / 2;
+    int lower = octant >= QUADRANTS;
+
+    return (box_t){quadrant.botLeftX, quadrant.botLeftY, lower ? box->botLeftZ : middleZ,
+                   quadrant.topRightX, quadrant.topRightY, lower ? middleZ : box->topRightZ};
+}
+
+// returns whether `point` belongs in `box`, in the plane as inRectangle sees it
+static inline int octContains(box_t* box, point3D_t* point) {
+    rectangle_t plane = octPlane(box);
+    return inRectangle(&plane, &(point_t){point->x, point->y}) &&
+        point->z >= box->botLeftZ && point->z < box->topRightZ;
+}
+
+// returns whether `point` is within `range`, borders included
+static inline int octHolds(box_t* range, point3D_t* point) {
+    return point->x >= range->botLeftX && point->x <= range->topRightX &&
+        point->y >= range->botLeftY && point->y <= range->topRightY &&
+        point->z >= range->botLeftZ && point->z <= range->topRightZ;
+}
+
+// returns whether `box` has any point in common with `range`, borders included
+static inline int octOverlaps(box_t* box, box_t* range) {
+    return box->botLeftX <= range->topRightX && box->topRightX >= range->botLeftX &&
+        box->botLeftY <= range->topRightY && box->topRightY >= range->botLeftY &&
+        box->botLeftZ <= range->topRightZ && box->topRightZ >= range->botLeftZ;
+}
+
+// returns whether points `a` and `b` are the same point to within EPSILON
+static inline int octSame(point3D_t* a, point3D_t* b) {
+    return fabs(a->x - b->x) < EPSILON && fabs(a->y - b->y) < EPSILON &&
+        fabs(a->z - b->z) < EPSILON;
+}
+
+// returns the span twice the size of `box` growing towards `point`, in the
+// plane as quadGrow does and down if `point` is below `box`, with the octant
+// `box` takes in it stored in `octant`
+static inline box_t octGrow(box_t* box, point3D_t* point, int* octant) {
+    assert(!isnan(point->z));
+
+    rectangle_t plane = octPlane(box);
+    int quadrant;
+    rectangle_t grown = quadGrow(&plane, &(point_t){point->x, point->y}, &quadrant);
+    long double depth = box->topRightZ - box->botLeftZ;
+    int below = point->z < box->botLeftZ;
+
+    *octant = below ? quadrant : QUADRANTS + quadrant;
+    return (box_t){grown.botLeftX, grown.botLeftY, below ? box->botLeftZ - depth : box->botLeftZ,
+                   grown.topRightX, grown.topRightY, below ? box->topRightZ : box->topRightZ + depth};
+}
+
+#endif
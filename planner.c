@@ -0,0 +1,188 @@
+/* Project: PR QuadTrees
+* planner.c :
+*            = implementation of the module planner of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "planner.h"
+#include "quadtree.h"
+#include "array.h"
+
+// returns whether no point of a node spanning `span` can be within `range`
+static int plannerDisjoint(rectangle_t* span, rectangle_t* range) {
+    return span->topRightX < range->botLeftX || span->botLeftX > range->topRightX ||
+        span->topRightY < range->botLeftY || span->botLeftY > range->topRightY;
+}
+
+// returns whether every point of a node spanning `span` is within `range`
+static int plannerContained(rectangle_t* span, rectangle_t* range) {
+    return range->botLeftX <= span->botLeftX && span->topRightX <= range->topRightX &&
+        range->botLeftY <= span->botLeftY && span->topRightY <= range->topRightY;
+}
+
+// returns the fraction of the area of `span` overlapping `range`
+static long double plannerOverlapArea(rectangle_t* span, rectangle_t* range) {
+    long double width = span->topRightX - span->botLeftX;
+    long double height = span->topRightY - span->botLeftY;
+    if (width <= 0 || height <= 0)
+        return 1;
+
+    long double left = span->botLeftX > range->botLeftX ? span->botLeftX : range->botLeftX;
+    long double right = span->topRightX < range->topRightX ? span->topRightX : range->topRightX;
+    long double bottom = span->botLeftY > range->botLeftY ? span->botLeftY : range->botLeftY;
+    long double top = span->topRightY < range->topRightY ? span->topRightY : range->topRightY;
+    if (right <= left || top <= bottom)
+        return 0;
+
+    return ((right - left) * (top - bottom)) / (width * height);
+}
+
+// recursively estimates the number of footpaths below `node` within `range`
+// nodes `depth` levels down are assumed to be uniformly filled
+static double plannerEstimate(qTreeNode_t* node, rectangle_t* range, int depth) {
+    if (node->count == 0 || plannerDisjoint(node->rectangle, range))
+        return 0;
+
+    if (plannerContained(node->rectangle, range))
+        return node->count;
+
+    if (node->point != NULL)
+        return inRectangleStage4(range, node->point) ? node->count : 0;
+
+    if (depth == 0 || node->NW == NULL)
+        return node->count * plannerOverlapArea(node->rectangle, range);
+
+    return plannerEstimate(node->NW, range, depth - 1) + plannerEstimate(node->NE, range, depth - 1) +
+        plannerEstimate(node->SW, range, depth - 1) + plannerEstimate(node->SE, range, depth - 1);
+}
+
+// returns the estimated fraction of the footpaths of `qTree` within `range`
+// from the counts of the nodes in the top ESTIMATE_DEPTH levels of `qTree`
+double qTreeEstimateSelectivity(qTree_t* qTree, rectangle_t* range) {
+    if (qTree->root->count == 0)
+        return 0;
+
+    return plannerEstimate(qTree->root, range, ESTIMATE_DEPTH) / qTree->root->count;
+}
+
+// recursively appends the footpaths of points below `node` within `range` to `found`
+// subtrees within `range` are appended whole without testing their points
+static void plannerWalk(qTreeNode_t* node, rectangle_t* range, queryStats_t* stats, array_t* found) {
+    if (node->count == 0 || plannerDisjoint(node->rectangle, range))
+        return;
+
+    stats->nodesVisited++;
+
+    if (plannerContained(node->rectangle, range)) {
+        stats->nodesContained++;
+        qTreeCollectFootpaths(node, found);
+        return;
+    }
+
+    if (node->point != NULL) {
+        stats->pointsTested++;
+        if (inRectangleStage4(range, node->point)) {
+            for (int i = 0; i < node->footpaths->n; i++)
+                arrayAppend(found, node->footpaths->A[i]);
+        }
+        return;
+    }
+
+    if (node->NW) {
+        plannerWalk(node->SW, range, stats, found);
+        plannerWalk(node->NW, range, stats, found);
+        plannerWalk(node->NE, range, stats, found);
+        plannerWalk(node->SE, range, stats, found);
+    }
+}
+
+// recursively appends the point of every leaf below `node` to the flat array of `qTree`
+static void plannerFlattenNode(qTree_t* qTree, qTreeNode_t* node) {
+    if (node->point != NULL) {
+        flatPoint_t* flatPoint = &qTree->flatPoints[qTree->nFlatPoints++];
+        flatPoint->x = node->point->x;
+        flatPoint->y = node->point->y;
+        flatPoint->leaf = node;
+    }
+
+    if (node->NW) {
+        plannerFlattenNode(qTree, node->NW);
+        plannerFlattenNode(qTree, node->NE);
+        plannerFlattenNode(qTree, node->SW);
+        plannerFlattenNode(qTree, node->SE);
+    }
+}
+
+// builds the flat array of the points of `qTree` scanned by qTreePlannedRange from now on
+// the array is dropped when a point is inserted into `qTree` or it is frozen
+void plannerBuild(qTree_t* qTree) {
+    free(qTree->flatPoints);
+
+    // every point holds at least one footpath so the count bounds the points
+    int size = qTree->root->count > 0 ? qTree->root->count : 1;
+    qTree->flatPoints = malloc(size * sizeof(*qTree->flatPoints));
+    assert(qTree->flatPoints);
+
+    qTree->nFlatPoints = 0;
+    plannerFlattenNode(qTree, qTree->root);
+    qTree->flatPoints = realloc(qTree->flatPoints, (qTree->nFlatPoints > 0 ? qTree->nFlatPoints : 1) *
+                                sizeof(*qTree->flatPoints));
+    assert(qTree->flatPoints);
+}
+
+// appends the footpaths of every point of `qTree` within `range` to `found`
+static void plannerScan(qTree_t* qTree, rectangle_t* range, queryStats_t* stats, array_t* found) {
+    for (int i = 0; i < qTree->nFlatPoints; i++) {
+        point_t point = {qTree->flatPoints[i].x, qTree->flatPoints[i].y};
+        if (inRectangleStage4(range, &point)) {
+            array_t* footpaths = qTree->flatPoints[i].leaf->footpaths;
+            for (int j = 0; j < footpaths->n; j++)
+                arrayAppend(found, footpaths->A[j]);
+        }
+    }
+    stats->pointsTested += qTree->nFlatPoints;
+}
+
+// searches `qTree` for points within `range`, choosing between walking the tree
+// and scanning a flat array of its points by the estimated fraction of `qTree`
+// within `range` against `scanThreshold`, always walking it before plannerBuild
+// stores unique footpaths of those points into `results` sorted by footpathID
+// and what was chosen into `stats`
+array_t* qTreePlannedRange(qTree_t* qTree, rectangle_t* range, double scanThreshold,
+                        queryStats_t* stats, array_t* results) {
+    memset(stats, 0, sizeof(*stats));
+    stats->selectivity = qTreeEstimateSelectivity(qTree, range);
+    stats->plan = qTree->flatPoints != NULL && stats->selectivity > scanThreshold ? PLAN_SCAN : PLAN_TREE;
+
+    // footpaths are gathered unsorted and deduplicated once at the end
+    // instead of keeping a sorted array of visited footpaths
+    array_t* found = arrayCreate();
+    if (stats->plan == PLAN_SCAN)
+        plannerScan(qTree, range, stats, found);
+    else
+        plannerWalk(qTree->root, range, stats, found);
+
+    arraySort(found);
+    for (int i = 0; i < found->n; i++) {
+        if (i == 0 || footpathGetID(found->A[i]) != footpathGetID(found->A[i - 1]))
+            arrayAppend(results, found->A[i]);
+    }
+
+    arrayFreeShallow(found);
+    return results;
+}
+
+// prints `stats` to `outFile`
+void queryStatsPrint(queryStats_t* stats, FILE* outFile) {
+    fprintf(outFile, "plan: %s || selectivity: %.4lf || nodes visited: %d ||"
+            " nodes contained: %d || points tested: %d\n",
+            stats->plan == PLAN_SCAN ? "scan" : "tree", stats->selectivity,
+            stats->nodesVisited, stats->nodesContained, stats->pointsTested);
+}
@@ -0,0 +1,56 @@
+/* Project: PR QuadTrees
+* planner.h :
+*            = interface of the module planner of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _PLANNER_H_
+#define _PLANNER_H_
+
+#include <stdio.h>
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+
+// plans the planner can choose for a range query
+#define PLAN_TREE 0  // walk the tree, emitting contained subtrees whole
+#define PLAN_SCAN 1  // scan the flat array of points of the tree
+
+// default estimated fraction of the tree within a query above which it is scanned
+#define SCAN_THRESHOLD 0.25
+
+// levels of the tree looked at when estimating the fraction within a query
+#define ESTIMATE_DEPTH 4
+
+// what the planner chose for a range query and what it cost
+typedef struct queryStats {
+    int plan;  // PLAN_TREE or PLAN_SCAN
+    double selectivity;  // estimated fraction of the footpaths of the tree within the range
+    int nodesVisited;  // nodes visited by the tree walk
+    int nodesContained;  // subtrees emitted whole without testing their points
+    int pointsTested;  // points tested against the range
+} queryStats_t;
+
+// builds the flat array of the points of `qTree` scanned by qTreePlannedRange from now on
+// the array is dropped when a point is inserted into `qTree` or it is frozen
+void plannerBuild(qTree_t* qTree);
+
+// searches `qTree` for points within `range`, choosing between walking the tree
+// and scanning a flat array of its points by the estimated fraction of `qTree`
+// within `range` against `scanThreshold`, always walking it before plannerBuild
+// stores unique footpaths of those points into `results` sorted by footpathID
+// and what was chosen into `stats`
+array_t* qTreePlannedRange(qTree_t* qTree, rectangle_t* range, double scanThreshold,
+                        queryStats_t* stats, array_t* results);
+
+// returns the estimated fraction of the footpaths of `qTree` within `range`
+// from the counts of the nodes in the top ESTIMATE_DEPTH levels of `qTree`
+double qTreeEstimateSelectivity(qTree_t* qTree, rectangle_t* range);
+
+// prints `stats` to `outFile`
+void queryStatsPrint(queryStats_t* stats, FILE* outFile);
+
+#endif
@@ -14,7 +14,9 @@
 
 #include "quadtree.h"
 #include "array.h"
-#include "linkedlist.h"
+#include "trace.h"
+#include "exactindex.h"
+#include "filter.h"
 
 // creates and returns a new point
 point_t* newPoint(double x, double y) {
@@ -71,27 +73,112 @@ int inRectangleStage4(rectangle_t* rectangle, point_t* point) {
     return 0;
 }
 
-// creates and returns empty quadTree
-qTree_t* qTreeCreate(rectangle_t* rectangle) {
+// returns 0,1,2 or 3 to specify which quadrant of `rectangle` `point` belongs in
+// returns -1 if point doesn't belong in either quadrant
+int rectangleQuadrant(rectangle_t* rectangle, point_t* point) {
+    long double middleX = (rectangle->botLeftX + rectangle->topRightX) / 2;
+    long double middleY = (rectangle->botLeftY + rectangle->topRightY) / 2;
+
+    // NW
+    if ((point->x <= middleX && point->y >= middleY) && 
+    (point->x > rectangle->botLeftX && point->y < rectangle->topRightY))
+        return 0;
+    
+    // NE
+    if ((point->x > middleX && point->y >= middleY) && 
+    (point->x <= rectangle->topRightX && point->y < rectangle->topRightY))
+        return 1;
+
+    // SW
+    if ((point->x <= middleX && point->y < middleY) && 
+    (point->x > rectangle->botLeftX && point->y >= rectangle->botLeftY))
+        return 2;
+
+    // SE
+    if ((point->x > middleX && point->y < middleY) && 
+    (point->x <= rectangle->topRightX && point->y >= rectangle->botLeftY))
+        return 3;
+
+    // doesn't fit in region of rectangle (not reached for this project)
+    return -1;
+}
+
+// returns the span of `quadrant` 0,1,2 or 3 of `rectangle`
+rectangle_t rectangleQuadrantSpan(rectangle_t* rectangle, int quadrant) {
+    long double middleX = (rectangle->botLeftX + rectangle->topRightX) / 2;
+    long double middleY = (rectangle->botLeftY + rectangle->topRightY) / 2;
+
+    if (quadrant == 0)
+        return (rectangle_t){rectangle->botLeftX, middleY, middleX, rectangle->topRightY};
+    if (quadrant == 1)
+        return (rectangle_t){middleX, middleY, rectangle->topRightX, rectangle->topRightY};
+    if (quadrant == 2)
+        return (rectangle_t){rectangle->botLeftX, rectangle->botLeftY, middleX, middleY};
+    return (rectangle_t){middleX, rectangle->botLeftY, rectangle->topRightX, middleY};
+}
+
+// returns the span twice the size of `rectangle` growing towards `point`, which is
+// outside of it, with the quadrant `rectangle` takes in the new span stored in `quadrant`
+// grows west or south only for points past those borders
+rectangle_t rectangleGrow(rectangle_t* rectangle, point_t* point, int* quadrant) {
+    assert(!isnan(point->x) && !isnan(point->y));
+
+    long double width = rectangle->topRightX - rectangle->botLeftX;
+    long double height = rectangle->topRightY - rectangle->botLeftY;
+    int west = point->x <= rectangle->botLeftX;
+    int south = point->y < rectangle->botLeftY;
+
+    // old span is the quadrant opposite to the way it grew
+    *quadrant = 2 * !south + west;
+    return (rectangle_t){
+        west ? rectangle->botLeftX - width : rectangle->botLeftX,
+        south ? rectangle->botLeftY - height : rectangle->botLeftY,
+        west ? rectangle->topRightX : rectangle->topRightX + width,
+        south ? rectangle->topRightY : rectangle->topRightY + height};
+}
+
+// returns whether points `a` and `b` are the same point to within EPSILON
+int samePoint(point_t* a, point_t* b) {
+    // using EPSILLON to deal with precision error because of equality testing of doubles
+    return (fabs(a->x - b->x) < EPSILON) && (fabs(a->y - b->y) < EPSILON);
+}
+
+// creates and returns empty quadTree holding the footpaths of `store`
+// `store` is owned by the tree from now on
+qTree_t* qTreeCreate(rectangle_t* rectangle, footpathStore_t* store) {
     qTree_t* qTree = malloc(sizeof(*qTree));  
     assert(qTree);
 
-    // creating initial root without a point and label
-    qTree->root = createNode(NULL, rectangle, "\0");
+    // creating initial root without a point and quadrant
+    qTree->root = createNode(NULL, rectangle, NO_QUADRANT);
+    qTree->store = store;
+    qTree->footpathPool = NULL;
+    qTree->nFootpaths = 0;
+    qTree->leafArrays = NULL;
+    qTree->nLeaves = 0;
+    qTree->flatPoints = NULL;
+    qTree->nFlatPoints = 0;
+    qTree->exactIndex = NULL;
+    qTree->frozenNodes = NULL;
+    qTree->nFrozenNodes = 0;
+    qTree->attributes = NULL;
 
     return qTree;
 }
 
 // creates and returns a node for `point` with `rectangle` (area of node)
-// and `label` (the quadrant the node is in)
-qTreeNode_t* createNode(point_t* point, rectangle_t* rectangle, char* label) {
+// and `quadrant` (the quadrant the node is in)
+qTreeNode_t* createNode(point_t* point, rectangle_t* rectangle, int quadrant) {
     qTreeNode_t* node = malloc(sizeof(*node));  
     assert(node);
 
     node->rectangle = rectangle;
     node->point = point;
     node->footpaths = arrayCreate();
-    node->label = label;
+    node->quadrant = quadrant;
+    node->count = 0;
+    node->summary = NULL;
+    node->representative = NULL;
     node->NE = NULL;
     node->NW = NULL;
     node->SE = NULL;
@@ -100,8 +187,39 @@ qTreeNode_t* createNode(point_t* point, rectangle_t* rectangle, char* label) {
     return node;
 }
 
-// handle function to insert `point` to `qTree`
+// creates and returns an empty node for `quadrant` of `rectangle`
+qTreeNode_t* createQuadrant(rectangle_t* rectangle, int quadrant) {
+    rectangle_t span = rectangleQuadrantSpan(rectangle, quadrant);
+    return createNode(NULL, newRectangle(span.botLeftX, span.botLeftY, span.topRightX, span.topRightY),
+                      quadrant);
+}
+
+// handle function to insert `point` to `qTree`, `footpath` is held by the store of `qTree`
+// grows `qTree` first if `point` is outside of its root
+// exits if `qTree` was finalized
 qTree_t* qTreeInsert(qTree_t* qTree, point_t* point, footpath_t* footpath) { 
+    // leaves of a finalized tree can't grow
+    if (qTree->footpathPool != NULL) {
+        fprintf(stderr, "cannot insert into a finalized quadtree\n");
+        exit(EXIT_FAILURE);
+    }
+    assert(footpath->store == qTree->store);
+
+    // flat array of points would be missing `point`
+    free(qTree->flatPoints);
+    qTree->flatPoints = NULL;
+    qTree->nFlatPoints = 0;
+
+    // quadrant paths in the exact index change when nodes split
+    if (qTree->exactIndex) {
+        exactIndexFree(qTree->exactIndex);
+        qTree->exactIndex = NULL;
+    }
+
+    // points outside the root are never dropped, the tree grows to take them
+    if (!inRectangle(qTree->root->rectangle, point))
+        qTreeGrow(qTree, point);
+
     // recursively inserts `point` into `qTree`
     qTreeInsertPoint(qTree->root, point, footpath);
 
@@ -109,14 +227,79 @@ qTree_t* qTreeInsert(qTree_t* qTree, point_t* point, footpath_t* footpath) {
 
 }
 
+// returns the smallest rectangle holding the start and end point of every footpath
+// in `footpaths`, borders moved out by a hair so every point is inside as inRectangle
+// sees it, a unit square if `footpaths` is empty
+rectangle_t* qTreeBounds(array_t* footpaths) {
+    if (footpaths->n == 0)
+        return newRectangle(0, 0, 1, 1);
+
+    long double minX = INFINITY, minY = INFINITY;
+    long double maxX = -INFINITY, maxY = -INFINITY;
+    for (int i = 0; i < footpaths->n; i++) {
+        footpath_t* footpath = footpaths->A[i];
+        double startLon = footpathGetStartLon(footpath), endLon = footpathGetEndLon(footpath);
+        double startLat = footpathGetStartLat(footpath), endLat = footpathGetEndLat(footpath);
+        minX = fminl(minX, fminl(startLon, endLon));
+        maxX = fmaxl(maxX, fmaxl(startLon, endLon));
+        minY = fminl(minY, fminl(startLat, endLat));
+        maxY = fmaxl(maxY, fmaxl(startLat, endLat));
+    }
+
+    // left and top borders are outside of the rectangle
+    long double marginX = fmaxl(maxX - minX, 1) * BOUNDS_MARGIN;
+    long double marginY = fmaxl(maxY - minY, 1) * BOUNDS_MARGIN;
+    return newRectangle(minX - marginX, minY - marginY, maxX + marginX, maxY + marginY);
+}
+
+// adds new roots above the root of `qTree` until `point` is within the root
+// every new root is twice the size of the old one, which becomes one of its
+// quadrants, growing towards `point` so the old nodes keep their spans
+void qTreeGrow(qTree_t* qTree, point_t* point) {
+    while (!inRectangle(qTree->root->rectangle, point)) {
+        qTreeNode_t* oldRoot = qTree->root;
+
+        int quadrant;
+        rectangle_t span = rectangleGrow(oldRoot->rectangle, point, &quadrant);
+        rectangle_t* rectangle = newRectangle(span.botLeftX, span.botLeftY,
+                                            span.topRightX, span.topRightY);
+
+        qTreeNode_t* root = createNode(NULL, rectangle, NO_QUADRANT);
+        root->NW = quadrant == 0 ? oldRoot : createQuadrant(rectangle, 0);
+        root->NE = quadrant == 1 ? oldRoot : createQuadrant(rectangle, 1);
+        root->SW = quadrant == 2 ? oldRoot : createQuadrant(rectangle, 2);
+        root->SE = quadrant == 3 ? oldRoot : createQuadrant(rectangle, 3);
+        oldRoot->quadrant = quadrant;
+
+        root->count = oldRoot->count;
+        qTree->root = root;
+    }
+}
+
+// inserts both the start and end point of `footpath` into `qTree`
+// both points share `footpath`, which is held by the store of `qTree`
+qTree_t* qTreeInsertFootpath(qTree_t* qTree, footpath_t* footpath) {
+    point_t* startPoint = newPoint(footpathGetStartLon(footpath), footpathGetStartLat(footpath));
+    point_t* endPoint = newPoint(footpathGetEndLon(footpath), footpathGetEndLat(footpath));
+
+    qTreeInsert(qTree, startPoint, footpath);
+    qTreeInsert(qTree, endPoint, footpath);
+
+    return qTree;
+}
+
 // inserts `footpath` into `arr` making sure `arr` stays sorted by footpathID
 void insertFootpathInArray(array_t *arr, footpath_t *footpath) {
+    // arrays are only shrunk by qTreeFinalize, shrinking on every
+    // insert would cost a realloc per footpath
     sortedArrayInsert(arr, footpath);
-    arrayShrink(arr);
 }
 
 // recursively inserts point into qTree
 void qTreeInsertPoint(qTreeNode_t* root, point_t* point, footpath_t* footpath) {
+    // `footpath` ends up in the subtree of every node it passes through
+    root->count++;
+
     // empty leaf node so insert `point`
     if (root->point == NULL && root->NW == NULL) {
         root->point = point;
@@ -126,8 +309,7 @@ void qTreeInsertPoint(qTreeNode_t* root, point_t* point, footpath_t* footpath) {
 
      // handling equality if point has already been inserted so just add footpaths
      if (root->point != NULL)
-        // using EPSILLON to deal with precision error because of equality testing of doubles
-        if ((fabs((root->point->x - point->x)) < EPSILON) && (fabs((root->point->y - point->y)) < EPSILON)) {
+        if (samePoint(root->point, point)) {
             insertFootpathInArray(root->footpaths, footpath);
 
             // freeing point now because point won't be inserted into node as it already exists
@@ -149,21 +331,11 @@ void qTreeInsertPoint(qTreeNode_t* root, point_t* point, footpath_t* footpath) {
 // function also reinserts current values of `node` 
 // into the appropriate new quadrant
 void splitNode(qTreeNode_t* node) {
-    long double middleX = (node->rectangle->botLeftX + node->rectangle->topRightX) / 2;
-    long double middleY = (node->rectangle->botLeftY + node->rectangle->topRightY) / 2;
-
     // creating quadrant children of node
-    rectangle_t* NW = newRectangle(node->rectangle->botLeftX, middleY, middleX, node->rectangle->topRightY);
-    node->NW = createNode(NULL, NW, "NW");
-
-    rectangle_t* NE = newRectangle(middleX, middleY, node->rectangle->topRightX, node->rectangle->topRightY);
-    node->NE = createNode(NULL, NE, "NE");
-
-    rectangle_t* SW = newRectangle(node->rectangle->botLeftX, node->rectangle->botLeftY, middleX, middleY);
-    node->SW = createNode(NULL, SW, "SW");
-
-    rectangle_t* SE = newRectangle(middleX, node->rectangle->botLeftY, node->rectangle->topRightX, middleY);
-    node->SE = createNode(NULL, SE, "SE");
+    node->NW = createQuadrant(node->rectangle, 0);
+    node->NE = createQuadrant(node->rectangle, 1);
+    node->SW = createQuadrant(node->rectangle, 2);
+    node->SE = createQuadrant(node->rectangle, 3);
 
     // insert point already in node into a children of node as node is now an interval node
     int quadrant = insertIntoQuadrant(node, node->point, node->footpaths->A[0]);
@@ -184,6 +356,10 @@ void splitNode(qTreeNode_t* node) {
         node->footpaths->A[i] = NULL;  
     }
 
+    // first footpath was counted when inserted into its quadrant
+    if (quadrant != -1 && node->footpaths->n > 1)
+        getQuadrant(node, quadrant)->count += node->footpaths->n - 1;
+
     node->footpaths->n = 0;
 
     // remove point from node as it is now an inner node
@@ -208,56 +384,87 @@ int insertIntoQuadrant(qTreeNode_t* node, point_t* point, footpath_t* footpath)
     return quadrant;
 }
 
+// returns the child of `node` in `quadrant` 0,1,2 or 3 as returned by findQuadrant
+qTreeNode_t* getQuadrant(qTreeNode_t* node, int quadrant) {
+    if (quadrant == 0)
+        return node->NW;
+    if (quadrant == 1)
+        return node->NE;
+    if (quadrant == 2)
+        return node->SW;
+    if (quadrant == 3)
+        return node->SE;
+    return NULL;
+}
+
 // returns 0,1,2 or 3 to specify which quadrant of `node` `point` belongs in
 // returns -1 if point doesn't belong in either quadrant
 int findQuadrant(qTreeNode_t* node, point_t* point) {
-    long double middleX = (node->rectangle->botLeftX + node->rectangle->topRightX) / 2;
-    long double middleY = (node->rectangle->botLeftY + node->rectangle->topRightY) / 2;
+    return rectangleQuadrant(node->rectangle, point);
+}
 
-    // NW
-    if ((point->x <= middleX && point->y >= middleY) && 
-    (point->x > node->rectangle->botLeftX && point->y < node->rectangle->topRightY))
-        return 0;
-    
-    // NE
-    if ((point->x > middleX && point->y >= middleY) && 
-    (point->x <= node->rectangle->topRightX && point->y < node->rectangle->topRightY))
-        return 1;
+// searches the frozen block of `qTree` for `point` as qTreeSearchNode searches its nodes
+static void qTreeFrozenSearch(qTree_t* qTree, point_t* point, trace_t* trace,
+                              FILE* infoFile, char* xBuffer, char* yBuffer) {
+    frozenNode_t* frozen = &qTree->frozenNodes[0];
 
-    // SW
-    if ((point->x <= middleX && point->y < middleY) && 
-    (point->x > node->rectangle->botLeftX && point->y >= node->rectangle->botLeftY))
-        return 2;
+    // inner nodes holding `point` are traced on the way down, the root only as a tile
+    while (frozen->children != 0) {
+        if (!inRectangle(&frozen->rectangle, point))
+            return;
 
-    // SE
-    if ((point->x > middleX && point->y < middleY) && 
-    (point->x <= node->rectangle->topRightX && point->y >= node->rectangle->botLeftY))
-        return 3;
+        if (frozen->quadrant != NO_QUADRANT)
+            traceAppend(trace, frozen->quadrant);
 
-    // doesn't fit in region of node (not reached for this project)
-    return -1;
+        int quadrant = rectangleQuadrant(&frozen->rectangle, point);
+        if (quadrant == -1)
+            return;
+        frozen = &qTree->frozenNodes[frozen->children + quadrant];
+    }
+
+    if (frozen->leaf != NO_FROZEN_LEAF && samePoint(&frozen->point, point)) {
+        traceAppend(trace, frozen->quadrant);
+
+        // printing all footpaths in found point
+        array_t* footpaths = &qTree->leafArrays[frozen->leaf];
+        fprintf(infoFile, "%s %s\n", xBuffer, yBuffer);
+        for (int i = 0; i < footpaths->n; i++)
+            footpathPrint(footpaths->A[i], infoFile);
+    }
 }
 
 // handle to search `qTree` for `point`
-// returns list of quadrants accessed in order to reach `point`
-void qTreeSearch(qTree_t *qTree, point_t* point, list_t* quadrants, 
+// appends quadrants accessed in order to reach `point` to `trace`
+// uses the exact index of `qTree` if one was built, `trace` may be NULL
+// walks the frozen block of `qTree` if it was frozen
+void qTreeSearch(qTree_t *qTree, point_t* point, trace_t* trace, 
                 FILE* infoFile, char* xBuffer, char* yBuffer) {
 
+    // points in the exact index don't need the tree to be walked
+    if (qTree->exactIndex &&
+        exactIndexSearch(qTree->exactIndex, point, trace, infoFile, xBuffer, yBuffer))
+        return;
+
+    if (qTree->frozenNodes != NULL) {
+        qTreeFrozenSearch(qTree, point, trace, infoFile, xBuffer, yBuffer);
+        return;
+    }
+
     // handles recursion
-    qTreeSearchNode(qTree->root, point, quadrants, infoFile, xBuffer, yBuffer);
+    qTreeSearchNode(qTree->root, point, trace, infoFile, xBuffer, yBuffer);
 }
 
 // recursively searches qTree for `point` by checking `node`
-void qTreeSearchNode(qTreeNode_t* node, point_t* point, list_t* quadrants,
+void qTreeSearchNode(qTreeNode_t* node, point_t* point, trace_t* trace,
                      FILE* infoFile,  char* xBuffer, char* yBuffer) {
 
     // leaf node
     if (node->NW == NULL) {
-        if ((fabs(node->point->x - point->x) < EPSILON) && (fabs(node->point->y - point->y) < EPSILON)) {
+        if (node->point != NULL && samePoint(node->point, point)) {
             // found point in node
 
-            // appending current quadrant to list
-            listAppend(quadrants, node->label); 
+            // appending current quadrant to trace
+            traceAppend(trace, node->quadrant); 
 
             // printing all footpaths in found point
             fprintf(infoFile, "%s %s\n", xBuffer, yBuffer);
@@ -266,47 +473,106 @@ void qTreeSearchNode(qTreeNode_t* node, point_t* point, list_t* quadrants,
             }
             return;
         } else {
-            return;  // leaf node does not contain the point so return 
+            return;  // leaf node is empty or does not contain the point so return 
         }
     }
 
-    // if point is within current rectangle append quadrant to list of quadrants
+    // if point is within current rectangle append quadrant to trace
     if (inRectangle(node->rectangle, point)) {
         // skipping root node since it does not have a quadrant
-        if (node->label[0] != '\0')  
-            listAppend(quadrants, node->label);
+        if (node->quadrant != NO_QUADRANT)  
+            traceAppend(trace, node->quadrant);
 
         // recursively searching appropriate quadrant
         int quadrant = findQuadrant(node, point);
         if (quadrant == 0) {
-            qTreeSearchNode(node->NW, point, quadrants,
+            qTreeSearchNode(node->NW, point, trace,
                              infoFile, xBuffer, yBuffer);
         } else if (quadrant == 1) {
-            qTreeSearchNode(node->NE, point, quadrants,
+            qTreeSearchNode(node->NE, point, trace,
                              infoFile, xBuffer, yBuffer);
         } else if (quadrant == 2) {
-            qTreeSearchNode(node->SW, point, quadrants,
+            qTreeSearchNode(node->SW, point, trace,
                              infoFile, xBuffer, yBuffer);
         } else if (quadrant == 3) {
-            qTreeSearchNode(node->SE, point, quadrants,
+            qTreeSearchNode(node->SE, point, trace,
                              infoFile, xBuffer, yBuffer);
         }
     }
 }
 
+// returns the leaf node of `qTree` holding `point`, NULL if `point` is not in `qTree`
+qTreeNode_t* qTreeFindLeaf(qTree_t* qTree, point_t* point) {
+    qTreeNode_t* node = qTree->root;
+
+    while (node->NW != NULL) {
+        int quadrant = findQuadrant(node, point);
+        if (quadrant == 0) {
+            node = node->NW;
+        } else if (quadrant == 1) {
+            node = node->NE;
+        } else if (quadrant == 2) {
+            node = node->SW;
+        } else if (quadrant == 3) {
+            node = node->SE;
+        } else {
+            return NULL;  // point outside region of `qTree`
+        }
+    }
+
+    if (node->point != NULL && samePoint(node->point, point)) {
+        return node;
+    }
+    return NULL;
+}
+
+// returns the footpaths of the leaf of the frozen block of `qTree` holding `point`
+// NULL if `point` is not in `qTree`
+array_t* qTreeFrozenFind(qTree_t* qTree, point_t* point) {
+    frozenNode_t* frozen = &qTree->frozenNodes[0];
+
+    while (frozen->children != 0) {
+        int quadrant = rectangleQuadrant(&frozen->rectangle, point);
+        if (quadrant == -1)
+            return NULL;  // point outside region of `qTree`
+        frozen = &qTree->frozenNodes[frozen->children + quadrant];
+    }
+
+    if (frozen->leaf != NO_FROZEN_LEAF && samePoint(&frozen->point, point))
+        return &qTree->leafArrays[frozen->leaf];
+    return NULL;
+}
+
+// recursively appends every footpath stored below `node` to `footpaths`
+// footpaths with both points below `node` are appended once per point
+void qTreeCollectFootpaths(qTreeNode_t* node, array_t* footpaths) {
+    // leaves holding a point are the only nodes with footpaths
+    if (node->point != NULL) {
+        for (int i = 0; i < node->footpaths->n; i++)
+            arrayAppend(footpaths, node->footpaths->A[i]);
+    }
+
+    if (node->NW) {
+        qTreeCollectFootpaths(node->NW, footpaths);
+        qTreeCollectFootpaths(node->NE, footpaths);
+        qTreeCollectFootpaths(node->SW, footpaths);
+        qTreeCollectFootpaths(node->SE, footpaths);
+    }
+}
+
 // recursively searches qTree for points within `range`
-// stores unique footpaths of those points and direction 
+// stores unique footpaths of those points and direction, `trace` may be NULL
 array_t* queryRange(qTreeNode_t* node, rectangle_t* range,
-             array_t* footpathVisited, list_t* quadrants, array_t* results) {
+             array_t* footpathVisited, trace_t* trace, array_t* results) {
 
     // node span and range of query don't overlap so return
     if (!rectangleOverlap(node->rectangle, range)) {
         return results;
     }
 
-    // not an empty leaf node so append current quadrant to list
+    // not an empty leaf node so append current quadrant to trace
     if (!(node->NW == NULL && node->point == NULL))  
-        listAppend(quadrants, node->label);
+        traceAppend(trace, node->quadrant);
 
     // got to a leaf node
     if (node->point != NULL) {
@@ -328,39 +594,57 @@ array_t* queryRange(qTreeNode_t* node, rectangle_t* range,
         return results;
 
     // recursively checking all quadrants of current node in order specified to check for any points in query range
-    array_t* SW = queryRange(node->SW, range, footpathVisited, quadrants, results);
-    for (int i = 0; i < SW->n; i++) {
-        if (arrayBinarySearch(footpathVisited, footpathGetID(SW->A[i])) == NULL) {
-            insertFootpathInArray(results, SW->A[i]);
-            insertFootpathInArray(footpathVisited, SW->A[i]);
-        }
-    }
+    // every quadrant adds its footpaths to `results` itself
+    queryRange(node->SW, range, footpathVisited, trace, results);
+    queryRange(node->NW, range, footpathVisited, trace, results);
+    queryRange(node->NE, range, footpathVisited, trace, results);
+    queryRange(node->SE, range, footpathVisited, trace, results);
 
-    array_t* NW = queryRange(node->NW, range, footpathVisited, quadrants, results);
-    for (int i = 0; i < NW->n; i++) {
-        if (arrayBinarySearch(footpathVisited, footpathGetID(NW->A[i])) == NULL) {
-            insertFootpathInArray(results, NW->A[i]);
-            insertFootpathInArray(footpathVisited, NW->A[i]);
-        }
-    }
+    return results;
+}
+
+// recursively searches the frozen block of `qTree` below `frozen` for points within `range`
+// as queryRange searches the nodes of `qTree`
+static void qTreeFrozenRange(qTree_t* qTree, frozenNode_t* frozen, rectangle_t* range,
+                             array_t* footpathVisited, trace_t* trace, array_t* results) {
+    if (!rectangleOverlap(&frozen->rectangle, range))
+        return;
 
-    array_t* NE = queryRange(node->NE, range, footpathVisited, quadrants, results);
-    for (int i = 0; i < NE->n; i++) {
-        if (arrayBinarySearch(footpathVisited, footpathGetID(NE->A[i])) == NULL) {
-            insertFootpathInArray(results, NE->A[i]);
-            insertFootpathInArray(footpathVisited, NE->A[i]);
+    // not an empty leaf node so append current quadrant to trace
+    if (frozen->children != 0 || frozen->leaf != NO_FROZEN_LEAF)
+        traceAppend(trace, frozen->quadrant);
+
+    if (frozen->leaf != NO_FROZEN_LEAF && inRectangleStage4(range, &frozen->point)) {
+        array_t* footpaths = &qTree->leafArrays[frozen->leaf];
+        for (int i = 0; i < footpaths->n; i++) {
+            if (arrayBinarySearch(footpathVisited, footpathGetID(footpaths->A[i])) == NULL) {
+                insertFootpathInArray(results, footpaths->A[i]);
+                insertFootpathInArray(footpathVisited, footpaths->A[i]);
+            }
         }
     }
 
-    array_t* SE = queryRange(node->SE, range, footpathVisited, quadrants, results);
-    for (int i = 0; i < SE->n; i++) {
-        if (arrayBinarySearch(footpathVisited, footpathGetID(SE->A[i])) == NULL) {
-            insertFootpathInArray(results, SE->A[i]);
-            insertFootpathInArray(footpathVisited, SE->A[i]);
-        }
+    if (frozen->children == 0)
+        return;
+
+    // same order of quadrants as queryRange, SW, NW, NE then SE
+    frozenNode_t* children = &qTree->frozenNodes[frozen->children];
+    qTreeFrozenRange(qTree, &children[2], range, footpathVisited, trace, results);
+    qTreeFrozenRange(qTree, &children[0], range, footpathVisited, trace, results);
+    qTreeFrozenRange(qTree, &children[1], range, footpathVisited, trace, results);
+    qTreeFrozenRange(qTree, &children[3], range, footpathVisited, trace, results);
+}
+
+// handle to search `qTree` for points within `range` as queryRange does
+// walks the frozen block of `qTree` if it was frozen, `trace` may be NULL
+array_t* qTreeRange(qTree_t* qTree, rectangle_t* range,
+                array_t* footpathVisited, trace_t* trace, array_t* results) {
+    if (qTree->frozenNodes != NULL) {
+        qTreeFrozenRange(qTree, &qTree->frozenNodes[0], range, footpathVisited, trace, results);
+        return results;
     }
 
-    return results;
+    return queryRange(qTree->root, range, footpathVisited, trace, results);
 }
 
 // checks if rectangles `a` and `b` have any overlap
@@ -410,9 +694,241 @@ int rectangleCornerInRectangle(long double x, long double y,
     return 0;
 }
 
+// recursively counts leaves holding a point and their footpaths below `node`
+static void qTreeCountLeaves(qTreeNode_t* node, int* nLeaves, int* nFootpaths) {
+    if (node->point != NULL) {
+        (*nLeaves)++;
+        *nFootpaths += node->footpaths->n;
+    }
+
+    if (node->NW) {
+        qTreeCountLeaves(node->NW, nLeaves, nFootpaths);
+        qTreeCountLeaves(node->NE, nLeaves, nFootpaths);
+        qTreeCountLeaves(node->SW, nLeaves, nFootpaths);
+        qTreeCountLeaves(node->SE, nLeaves, nFootpaths);
+    }
+}
+
+// recursively moves footpaths below `node` into the pool of `qTree`
+// and frees the arrays of nodes without a point
+// the count of a node is recounted from its leaves, so trees built without
+// keeping counts (qTreeConcurrentInsert) get them here
+// the representative of a node is the representative of its fullest child
+static void qTreeFinalizeNode(qTree_t* qTree, qTreeNode_t* node) {
+    node->count = 0;
+    if (node->point != NULL) {
+        // leaf array becomes (offset, count) of the pool
+        array_t* leafArray = &qTree->leafArrays[qTree->nLeaves++];
+        leafArray->A = qTree->footpathPool + qTree->nFootpaths;
+        leafArray->n = node->footpaths->n;
+        leafArray->size = node->footpaths->n;
+
+        memcpy(leafArray->A, node->footpaths->A, node->footpaths->n * sizeof(*leafArray->A));
+        qTree->nFootpaths += node->footpaths->n;
+
+        arrayFreeShallow(node->footpaths);
+        node->footpaths = leafArray;
+        node->count = leafArray->n;
+    } else if (node->footpaths != NULL) {
+        // inner and empty leaf nodes never hold footpaths
+        arrayFreeShallow(node->footpaths);
+        node->footpaths = NULL;
+    }
+
+    if (node->NW) {
+        qTreeFinalizeNode(qTree, node->NW);
+        qTreeFinalizeNode(qTree, node->NE);
+        qTreeFinalizeNode(qTree, node->SW);
+        qTreeFinalizeNode(qTree, node->SE);
+        node->count = node->NW->count + node->NE->count + node->SW->count + node->SE->count;
+
+        qTreeNode_t* fullest = node->NW;
+        for (int quadrant = 1; quadrant < 4; quadrant++) {
+            if (getQuadrant(node, quadrant)->count > fullest->count)
+                fullest = getQuadrant(node, quadrant);
+        }
+        node->representative = fullest->representative;
+    } else if (node->point != NULL) {
+        node->representative = node->footpaths->A[0];
+    }
+}
+
+// compacts `qTree` once it is fully built, no points can be inserted after
+// frees the footpath arrays of inner and empty leaf nodes and repacks the
+// footpaths of every leaf into one contiguous pool and shrinks the columns of its store
+// every node gets the count and a representative footpath of its subtree
+void qTreeFinalize(qTree_t* qTree) {
+    if (qTree->footpathPool != NULL)
+        return;
+
+    footpathStoreShrink(qTree->store);
+
+    int nLeaves = 0, nFootpaths = 0;
+    qTreeCountLeaves(qTree->root, &nLeaves, &nFootpaths);
+
+    // allocating at least one so a finalized tree always has a pool
+    qTree->footpathPool = malloc((nFootpaths > 0 ? nFootpaths : 1) * sizeof(*qTree->footpathPool));
+    qTree->leafArrays = malloc((nLeaves > 0 ? nLeaves : 1) * sizeof(*qTree->leafArrays));
+    assert(qTree->footpathPool && qTree->leafArrays);
+
+    // counts are rebuilt while filling the pool
+    qTree->nLeaves = 0;
+    qTree->nFootpaths = 0;
+    qTreeFinalizeNode(qTree, qTree->root);
+}
+
+// function to recursively free a finalized qTree by traversing every `node`
+// leaf arrays are freed with the pool of the tree and footpaths with its store
+static void qTreeFreeFinalizedNode(qTreeNode_t* node) {
+    free(node->point);
+    free(node->rectangle);
+
+    if (node->NW) {
+        qTreeFreeFinalizedNode(node->NW);
+        qTreeFreeFinalizedNode(node->NE);
+        qTreeFreeFinalizedNode(node->SW);
+        qTreeFreeFinalizedNode(node->SE);
+    }
+
+    free(node);
+}
+
+// recursively counts the nodes below `node`
+static int qTreeCountNodes(qTreeNode_t* node) {
+    if (node->NW == NULL)
+        return 1;
+
+    return 1 + qTreeCountNodes(node->NW) + qTreeCountNodes(node->NE) +
+        qTreeCountNodes(node->SW) + qTreeCountNodes(node->SE);
+}
+
+// copies `node` of finalized `qTree` with its span and point into `frozen`
+static void qTreeFreezeCopy(qTree_t* qTree, frozenNode_t* frozen, qTreeNode_t* node) {
+    frozen->rectangle = *node->rectangle;
+    frozen->quadrant = node->quadrant;
+    frozen->children = 0;
+    frozen->leaf = NO_FROZEN_LEAF;
+
+    if (node->point != NULL) {
+        frozen->point = *node->point;
+        frozen->leaf = node->footpaths - qTree->leafArrays;
+    }
+}
+
+// recursively copies the children of `node`, already copied to `frozen`, into
+// the next four nodes of the block of `qTree` followed by their subtrees
+static void qTreeFreezeChildren(qTree_t* qTree, frozenNode_t* frozen, qTreeNode_t* node) {
+    if (node->NW == NULL)
+        return;
+
+    frozenNode_t* children = &qTree->frozenNodes[qTree->nFrozenNodes];
+    frozen->children = qTree->nFrozenNodes;
+    qTree->nFrozenNodes += 4;
+
+    for (int quadrant = 0; quadrant < 4; quadrant++)
+        qTreeFreezeCopy(qTree, &children[quadrant], getQuadrant(node, quadrant));
+
+    for (int quadrant = 0; quadrant < 4; quadrant++)
+        qTreeFreezeChildren(qTree, &children[quadrant], getQuadrant(node, quadrant));
+}
+
+// copies a finalized `qTree` into one contiguous block of nodes, read only after
+// the four children of a node are next to each other and every subtree
+// takes a contiguous run of the block, so walks down the tree stay close in memory
+// the nodes stay for the walks that don't read the block
+void qTreeFreeze(qTree_t* qTree) {
+    if (qTree->frozenNodes != NULL)
+        return;
+
+    qTreeFinalize(qTree);
+
+    int nNodes = qTreeCountNodes(qTree->root);
+    frozenNode_t* frozenNodes = malloc(nNodes * sizeof(*frozenNodes));
+    assert(frozenNodes);
+    qTree->frozenNodes = frozenNodes;
+
+    qTree->nFrozenNodes = 1;
+    qTreeFreezeCopy(qTree, &frozenNodes[0], qTree->root);
+    qTreeFreezeChildren(qTree, &frozenNodes[0], qTree->root);
+}
+
+// recursively adds up the bytes of memory used below `node` into `memory`
+static void qTreeNodeMemoryUsage(qTreeNode_t* node, int finalized, qTreeMemory_t* memory) {
+    memory->nodes += sizeof(*node);
+    memory->rectangles += sizeof(*node->rectangle);
+
+    if (node->point != NULL)
+        memory->points += sizeof(*node->point);
+
+    if (node->footpaths != NULL) {
+        // arrays of a finalized tree are counted with its pool
+        if (!finalized) {
+            memory->footpathArrays += sizeof(*node->footpaths) +
+                                    node->footpaths->size * sizeof(*node->footpaths->A);
+        }
+    }
+
+    if (node->NW) {
+        qTreeNodeMemoryUsage(node->NW, finalized, memory);
+        qTreeNodeMemoryUsage(node->NE, finalized, memory);
+        qTreeNodeMemoryUsage(node->SW, finalized, memory);
+        qTreeNodeMemoryUsage(node->SE, finalized, memory);
+    }
+}
+
+// adds up the bytes of memory used by `qTree` into `memory`
+void qTreeMemoryUsage(qTree_t* qTree, qTreeMemory_t* memory) {
+    memset(memory, 0, sizeof(*memory));
+    memory->nodes += sizeof(*qTree);
+
+    int finalized = qTree->footpathPool != NULL;
+    if (finalized) {
+        memory->footpathArrays += qTree->nLeaves * sizeof(*qTree->leafArrays) +
+                                qTree->nFootpaths * sizeof(*qTree->footpathPool);
+    }
+    memory->points += qTree->nFlatPoints * sizeof(*qTree->flatPoints);
+    memory->records += footpathStoreColumnBytes(qTree->store);
+    memory->strings += footpathStoreStringBytes(qTree->store);
+    qTreeNodeMemoryUsage(qTree->root, finalized, memory);
+
+    // the frozen block is a copy of the nodes with their spans and points
+    if (qTree->frozenNodes != NULL)
+        memory->nodes += qTree->nFrozenNodes * sizeof(*qTree->frozenNodes);
+}
+
+// returns the total bytes of memory in `memory`
+size_t qTreeMemoryTotal(qTreeMemory_t* memory) {
+    return memory->nodes + memory->points + memory->rectangles +
+        memory->footpathArrays + memory->records + memory->strings;
+}
+
+// prints the bytes of memory used by every structure in `memory` to `outFile`
+void qTreeMemoryPrint(qTreeMemory_t* memory, FILE* outFile) {
+    fprintf(outFile, "nodes: %zu\n", memory->nodes);
+    fprintf(outFile, "points: %zu\n", memory->points);
+    fprintf(outFile, "rectangles: %zu\n", memory->rectangles);
+    fprintf(outFile, "footpath arrays: %zu\n", memory->footpathArrays);
+    fprintf(outFile, "records: %zu\n", memory->records);
+    fprintf(outFile, "strings: %zu\n", memory->strings);
+    fprintf(outFile, "total: %zu\n", qTreeMemoryTotal(memory));
+}
+
 // handle function to free allocated memory used by `qTree`
 void qTreeFree(qTree_t *qTree) {
-    qTreeFreeNode(qTree->root);
+    if (qTree->footpathPool != NULL) {
+        free(qTree->frozenNodes);
+        qTreeFreeFinalizedNode(qTree->root);
+        free(qTree->footpathPool);
+        free(qTree->leafArrays);
+    } else {
+        qTreeFreeNode(qTree->root);
+    }
+    free(qTree->flatPoints);
+    if (qTree->exactIndex)
+        exactIndexFree(qTree->exactIndex);
+    if (qTree->attributes)
+        attributeIndexFree(qTree->attributes);
+    footpathStoreFree(qTree->store);
     free(qTree);
 }
 
@@ -420,7 +936,8 @@ void qTreeFree(qTree_t *qTree) {
 void qTreeFreeNode(qTreeNode_t* node) {
     free(node->point);
     
-    arrayFree(node->footpaths);
+    if (node->footpaths)
+        arrayFreeShallow(node->footpaths);
     free(node->rectangle);
     
     if (node->NW) {
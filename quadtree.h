@@ -9,13 +9,22 @@
 #ifndef _QUADTREE_H_
 #define _QUADTREE_H_
 
+#include <stdint.h>
+
 #include "data.h"
 #include "array.h"
-#include "linkedlist.h"
+#include "trace.h"
+#include "store.h"
 
 // epsilon value used for comparing equality of variables of type double
 #define EPSILON 1e-12  
 
+// fraction of the extent of the data the bounds from qTreeBounds leave around it
+#define BOUNDS_MARGIN 1e-9
+
+// leaf offset of a frozen node without footpaths
+#define NO_FROZEN_LEAF UINT32_MAX
+
 // struct to keep track of region spanned by node
 typedef struct rectangle2D {
     long double botLeftX;
@@ -38,15 +47,65 @@ typedef struct qTreeNode {
     struct qTreeNode *SE;
     rectangle_t* rectangle;  // span of node
     array_t* footpaths;  // dynamic sorted array to contains `footpaths` for the node
-    char* label;  // to specify which quadrant node is in 
+    char quadrant;  // to specify which quadrant node is in, NO_QUADRANT for the root
+    int count;  // number of footpaths stored in the subtree of the node
+    struct nodeSummary* summary;  // set by attributeIndexBuild, attributes of the subtree
+    footpath_t* representative;  // set by qTreeFinalize, stands in for the subtree at low detail
 } qTreeNode_t;
 
+// point of a leaf in the flat array of a qTree, scanned instead of the tree
+// by the query planner when most of the tree is within a query
+typedef struct flatPoint {
+    double x;
+    double y;
+    qTreeNode_t* leaf;
+} flatPoint_t;
+
+// node of a frozen qTree stored together with its span and point, without pointers
+// the block links its nodes by offsets from its start, so it stays valid wherever it is moved
+typedef struct frozenNode {
+    rectangle_t rectangle;
+    point_t point;  // only set for a node with a leaf
+    uint32_t children;  // offset of the first of the four children, NW NE SW SE, 0 for a leaf
+    uint32_t leaf;  // offset in `leafArrays` of the footpaths, NO_FROZEN_LEAF for none
+    char quadrant;  // as the quadrant of the node it was copied from
+} frozenNode_t;
+
 typedef struct quadTree {
     qTreeNode_t* root;
+    footpathStore_t* store;  // rows of every footpath in the tree, each stored once
+    // set by qTreeFinalize, the footpaths of every leaf one after the other
+    // each leaf's `footpaths` is an (offset, count) view into `footpathPool`
+    footpath_t** footpathPool;
+    int nFootpaths;  // footpaths in `footpathPool`
+    array_t* leafArrays;  // `footpaths` of every leaf holding a point
+    int nLeaves;  // leaves in `leafArrays`
+    // built by plannerBuild, freed when a point is inserted or the tree frozen
+    flatPoint_t* flatPoints;
+    int nFlatPoints;
+    // built by exactIndexBuild, freed when a point is inserted
+    struct exactIndex* exactIndex;
+    // set by qTreeFreeze, a copy of every node of the tree laid out depth first
+    // walked by qTreeSearch and qTreeRange instead of the nodes
+    frozenNode_t* frozenNodes;
+    int nFrozenNodes;
+    // built by attributeIndexBuild once the tree is finalized
+    struct attributeIndex* attributes;
 } qTree_t;
 
-// creates and returns empty quadTree
-qTree_t* qTreeCreate(rectangle_t* rectangle);
+// bytes of memory used by a qTree, by structure
+typedef struct qTreeMemory {
+    size_t nodes;
+    size_t points;
+    size_t rectangles;
+    size_t footpathArrays;  // array_t of nodes and the footpath pointers in them
+    size_t records;  // columns of the store and its footpath_t of every row
+    size_t strings;  // dictionaries of the strings of the store
+} qTreeMemory_t;
+
+// creates and returns empty quadTree holding the footpaths of `store`
+// `store` is owned by the tree from now on
+qTree_t* qTreeCreate(rectangle_t* rectangle, footpathStore_t* store);
 
 // creates and returns a new point
 point_t* newPoint(double x, double y);
@@ -67,14 +126,51 @@ int inRectangle(rectangle_t* rectangle, point_t* point);
 // returns 1(true) or 0(false)
 int inRectangleStage4(rectangle_t* rectangle, point_t* point);
 
-// handle function to insert `point` to `qTree`
+// returns 0,1,2 or 3 to specify which quadrant of `rectangle` `point` belongs in
+// returns -1 if point doesn't belong in either quadrant
+int rectangleQuadrant(rectangle_t* rectangle, point_t* point);
+
+// returns the span of `quadrant` 0,1,2 or 3 of `rectangle`
+rectangle_t rectangleQuadrantSpan(rectangle_t* rectangle, int quadrant);
+
+// returns the span twice the size of `rectangle` growing towards `point`, which is
+// outside of it, with the quadrant `rectangle` takes in the new span stored in `quadrant`
+// grows west or south only for points past those borders
+rectangle_t rectangleGrow(rectangle_t* rectangle, point_t* point, int* quadrant);
+
+// returns whether points `a` and `b` are the same point to within EPSILON
+int samePoint(point_t* a, point_t* b);
+
+// handle function to insert `point` to `qTree`, `footpath` is held by the store of `qTree`
+// grows `qTree` first if `point` is outside of its root
+// exits if `qTree` was finalized
 qTree_t* qTreeInsert(qTree_t* qTree, point_t* point, footpath_t* footpath);
 
+// returns the smallest rectangle holding the start and end point of every footpath
+// in `footpaths`, borders moved out by a hair so every point is inside as inRectangle
+// sees it, a unit square if `footpaths` is empty
+rectangle_t* qTreeBounds(array_t* footpaths);
+
+// adds new roots above the root of `qTree` until `point` is within the root
+// every new root is twice the size of the old one, which becomes one of its
+// quadrants, growing towards `point` so the old nodes keep their spans
+void qTreeGrow(qTree_t* qTree, point_t* point);
+
+// inserts both the start and end point of `footpath` into `qTree`
+// both points share `footpath`, which is held by the store of `qTree`
+qTree_t* qTreeInsertFootpath(qTree_t* qTree, footpath_t* footpath);
+
 // recursively inserts point into qTree
 void qTreeInsertPoint(qTreeNode_t* root, point_t* point, footpath_t* footpath);
 
-// creates and returns a node for `point` with `rectangle`and `label` 
-qTreeNode_t* createNode(point_t* point, rectangle_t* rectangle, char* label);
+// creates and returns a node for `point` with `rectangle`and `quadrant` 
+qTreeNode_t* createNode(point_t* point, rectangle_t* rectangle, int quadrant);
+
+// creates and returns an empty node for `quadrant` of `rectangle`
+qTreeNode_t* createQuadrant(rectangle_t* rectangle, int quadrant);
+
+// returns the child of `node` in `quadrant` 0,1,2 or 3 as returned by findQuadrant
+qTreeNode_t* getQuadrant(qTreeNode_t* node, int quadrant);
 
 // returns 0,1,2 or 3 to specify which quadrant of `node` `point` belongs in
 // returns -1 if point doesn't belong in either quadrant
@@ -87,18 +183,36 @@ int insertIntoQuadrant(qTreeNode_t* node, point_t* point, footpath_t* footpath);
 // function also reinserts current values of `node` into the appropriate new quadrant
 void splitNode(qTreeNode_t* node);
 
-// handle to search `qTree` for `point` and returns list of quadrants accessed in order to reach `point`
-void qTreeSearch(qTree_t *qTree, point_t* point, list_t* quadrants, 
+// handle to search `qTree` for `point` and appends quadrants accessed in order to reach `point` to `trace`
+// uses the exact index of `qTree` if one was built, `trace` may be NULL
+// walks the frozen block of `qTree` if it was frozen
+void qTreeSearch(qTree_t *qTree, point_t* point, trace_t* trace, 
                 FILE* infoFile, char* xBuffer, char* yBuffer);
 
 // recursively searches qTree for `point` by checking `node`
-void qTreeSearchNode(qTreeNode_t* node, point_t* point, list_t* quadrants, 
+void qTreeSearchNode(qTreeNode_t* node, point_t* point, trace_t* trace, 
                         FILE* infoFile,  char* xBuffer, char* yBuffer);
 
+// returns the leaf node of `qTree` holding `point`, NULL if `point` is not in `qTree`
+qTreeNode_t* qTreeFindLeaf(qTree_t* qTree, point_t* point);
+
+// returns the footpaths of the leaf of the frozen block of `qTree` holding `point`
+// NULL if `point` is not in `qTree`
+array_t* qTreeFrozenFind(qTree_t* qTree, point_t* point);
+
+// recursively appends every footpath stored below `node` to `footpaths`
+// footpaths with both points below `node` are appended once per point
+void qTreeCollectFootpaths(qTreeNode_t* node, array_t* footpaths);
+
 // recursively searches qTree for points within `range`
-// stores unique footpaths of those points and direction 
+// stores unique footpaths of those points and direction, `trace` may be NULL
 array_t* queryRange(qTreeNode_t* node, rectangle_t* range, 
-                array_t* footpathVisited, list_t* quadrants, array_t* results);
+                array_t* footpathVisited, trace_t* trace, array_t* results);
+
+// handle to search `qTree` for points within `range` as queryRange does
+// walks the frozen block of `qTree` if it was frozen, `trace` may be NULL
+array_t* qTreeRange(qTree_t* qTree, rectangle_t* range,
+                array_t* footpathVisited, trace_t* trace, array_t* results);
 
 // checks if rectangles `a` and `b` have any overlap
 int rectangleOverlap(rectangle_t* a, rectangle_t* b);
@@ -110,6 +224,27 @@ int rectangleCornerInRectangle(long double x, long double y,
 // inserts `footpath` into `arr` making sure `arr` stays sorted by footpathID
 void insertFootpathInArray(array_t *arr, footpath_t *footpath);
 
+// compacts `qTree` once it is fully built, no points can be inserted after
+// frees the footpath arrays of inner and empty leaf nodes and repacks the
+// footpaths of every leaf into one contiguous pool and shrinks the columns of its store
+// every node gets the count and a representative footpath of its subtree
+void qTreeFinalize(qTree_t* qTree);
+
+// copies a finalized `qTree` into one contiguous block of nodes, read only after
+// the four children of a node are next to each other and every subtree
+// takes a contiguous run of the block, so walks down the tree stay close in memory
+// the nodes stay for the walks that don't read the block
+void qTreeFreeze(qTree_t* qTree);
+
+// adds up the bytes of memory used by `qTree` into `memory`
+void qTreeMemoryUsage(qTree_t* qTree, qTreeMemory_t* memory);
+
+// returns the total bytes of memory in `memory`
+size_t qTreeMemoryTotal(qTreeMemory_t* memory);
+
+// prints the bytes of memory used by every structure in `memory` to `outFile`
+void qTreeMemoryPrint(qTreeMemory_t* memory, FILE* outFile);
+
 // handle function to free allocated memory used by `qTree`
 void qTreeFree(qTree_t *qTree);
 
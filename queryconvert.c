@@ -0,0 +1,37 @@
+/* Project: PR QuadTrees
+* queryconvert.c :
+*            = converter of text queries to binary query files of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* -------------------------------------------------------------- 
+* Read queries in the text format of stages 3 and 4 from stdin, one per
+* line, and write them to the binary query file given as the argument
+* for the driver to answer without parsing them
+*
+* Besides points "x y" and ranges "botLeftX botLeftY topRightX topRightY"
+* lines can hold "knn x y k" and "radius x y metres" queries
+*
+* ----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "queryfile.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s binaryFile < textFile\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    int nQueries = queryFileConvert(stdin, argv[1]);
+    if (nQueries == -1) {
+        fprintf(stderr, "invalid query in stdin or %s can't be written, nothing written\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(stderr, "%d queries written to %s\n", nQueries, argv[1]);
+    return 0;
+}
@@ -0,0 +1,203 @@
+/* Project: PR QuadTrees
+* queryfile.c :
+*            = implementation of the module queryfile of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "queryfile.h"
+
+// initial number of records and bytes of text the converter has room for
+#define CONVERT_INIT_SIZE 64
+
+// records and text of a query file being converted
+typedef struct queryConvert {
+    queryRecord_t* records;
+    int n;
+    int size;
+    char* text;
+    size_t textUsed;
+    size_t textSize;
+} queryConvert_t;
+
+// appends nul terminated `token` to the text of `convert`, returns its offset
+static unsigned int queryAppendText(queryConvert_t* convert, char* token) {
+    size_t length = strlen(token) + 1;
+    if (convert->textUsed + length > convert->textSize) {
+        convert->textSize = 2 * (convert->textUsed + length);
+        convert->text = realloc(convert->text, convert->textSize);
+        assert(convert->text);
+    }
+
+    unsigned int offset = convert->textUsed;
+    memcpy(convert->text + offset, token, length);
+    convert->textUsed += length;
+    return offset;
+}
+
+// parses text format `line` into `record`, returns 0 if it is not a query
+// and -1 if it is blank, in which case `record` is left untouched
+static int queryParseLine(queryConvert_t* convert, char* line, queryRecord_t* record) {
+    char* tokens[QUERY_VALUES + 1];
+    int nTokens = 0;
+    for (char* token = strtok(line, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n")) {
+        if (nTokens == QUERY_VALUES + 1)
+            return 0;
+        tokens[nTokens++] = token;
+    }
+    if (nTokens == 0)
+        return -1;
+
+    char** values = tokens;
+    memset(record, 0, sizeof(*record));
+    if (nTokens == 2) {
+        record->type = QUERY_POINT;
+    } else if (nTokens == 4 && strcmp(tokens[0], "knn") != 0 && strcmp(tokens[0], "radius") != 0) {
+        record->type = QUERY_RANGE;
+    } else if (nTokens == 4 && strcmp(tokens[0], "knn") == 0) {
+        record->type = QUERY_KNN;
+        values++;
+    } else if (nTokens == 4 && strcmp(tokens[0], "radius") == 0) {
+        record->type = QUERY_RADIUS;
+        values++;
+    } else {
+        return 0;
+    }
+    record->nValues = nTokens - (values - tokens);
+
+    for (int i = 0; i < record->nValues; i++) {
+        char* end;
+        // points are read with atof and everything else with strtold by the text readers
+        record->values[i] = record->type == QUERY_POINT ? strtod(values[i], &end) : strtold(values[i], &end);
+        if (end == values[i] || *end != '\0')
+            return 0;
+        record->text[i] = queryAppendText(convert, values[i]);
+    }
+    return 1;
+}
+
+// converts the queries of text format `textFile`, one per line, to binary query file `path`
+// blank lines are skipped, returns the number of queries written, -1 if a line
+// is not a query or `path` can't be written, in which case nothing is written
+int queryFileConvert(FILE* textFile, char* path) {
+    queryConvert_t convert;
+    convert.size = CONVERT_INIT_SIZE;
+    convert.records = malloc(convert.size * sizeof(*convert.records));
+    convert.textSize = CONVERT_INIT_SIZE;
+    convert.text = malloc(convert.textSize);
+    assert(convert.records && convert.text);
+    convert.n = 0;
+    convert.textUsed = 0;
+
+    // variables needed for getline function
+    char* linePtr = NULL;
+    size_t len = 0;
+    int valid = 1;
+
+    while (valid && getline(&linePtr, &len, textFile) != -1) {
+        if (convert.n == convert.size) {
+            convert.size *= 2;
+            convert.records = realloc(convert.records, convert.size * sizeof(*convert.records));
+            assert(convert.records);
+        }
+        int parsed = queryParseLine(&convert, linePtr, &convert.records[convert.n]);
+        if (parsed == 1)
+            convert.n++;
+        valid = parsed != 0;
+    }
+    free(linePtr);
+
+    if (valid) {
+        queryFileHeader_t header;
+        memset(&header, 0, sizeof(header));
+        header.magic = QUERY_FILE_MAGIC;
+        header.version = QUERY_FILE_VERSION;
+        header.valueSize = sizeof(long double);
+        header.nQueries = convert.n;
+        header.recordSize = sizeof(queryRecord_t);
+        header.textSize = convert.textUsed;
+
+        FILE* f = fopen(path, "wb");
+        if (f == NULL) {
+            valid = 0;
+        } else {
+            int written = fwrite(&header, sizeof(header), 1, f) == 1 &&
+                fwrite(convert.records, sizeof(*convert.records), convert.n, f) == (size_t)convert.n &&
+                fwrite(convert.text, 1, convert.textUsed, f) == convert.textUsed;
+
+            // a file cut short by a failed write isn't left behind
+            if (fclose(f) != 0 || !written) {
+                remove(path);
+                valid = 0;
+            }
+        }
+    }
+
+    free(convert.records);
+    free(convert.text);
+    return valid ? convert.n : -1;
+}
+
+// maps binary query file `path` into memory
+// returns NULL if `path` can't be read or isn't a query file written on this machine
+queryFile_t* queryFileOpen(char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < sizeof(queryFileHeader_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    char* file = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED)
+        return NULL;
+
+    // records are read in order, once
+    madvise(file, st.st_size, MADV_SEQUENTIAL);
+
+    // records start right after the header, which keeps them aligned
+    queryFileHeader_t* header = (queryFileHeader_t*)file;
+    size_t recordsSize = (size_t)header->nQueries * sizeof(queryRecord_t);
+    if (header->magic != QUERY_FILE_MAGIC || header->version != QUERY_FILE_VERSION ||
+        header->valueSize != sizeof(long double) || header->recordSize != sizeof(queryRecord_t) ||
+        sizeof(*header) + recordsSize + header->textSize != st.st_size ||
+        (header->textSize > 0 && file[st.st_size - 1] != '\0')) {
+        munmap(file, st.st_size);
+        return NULL;
+    }
+
+    queryFile_t* queryFile = malloc(sizeof(*queryFile));
+    assert(queryFile);
+    queryFile->header = header;
+    queryFile->records = (queryRecord_t*)(file + sizeof(*header));
+    queryFile->text = file + sizeof(*header) + recordsSize;
+    queryFile->size = st.st_size;
+
+    return queryFile;
+}
+
+// returns the text of value `value` of `record` of `queryFile`, as given in the text format
+char* queryFileText(queryFile_t* queryFile, queryRecord_t* record, int value) {
+    assert(value < record->nValues && record->text[value] < queryFile->header->textSize);
+    return queryFile->text + record->text[value];
+}
+
+// unmaps `queryFile` and frees the memory used by it
+void queryFileClose(queryFile_t* queryFile) {
+    munmap(queryFile->header, queryFile->size);
+    free(queryFile);
+}
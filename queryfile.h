@@ -0,0 +1,69 @@
+/* Project: PR QuadTrees
+* queryfile.h :
+*            = interface of the module queryfile of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _QUERYFILE_H_
+#define _QUERYFILE_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+// first bytes of a binary query file, "PRQF" read as a little endian int
+#define QUERY_FILE_MAGIC 0x46515250
+#define QUERY_FILE_VERSION 1
+
+// types of the queries of a binary query file, as written in the text format
+#define QUERY_POINT 0  // x y
+#define QUERY_RANGE 1  // botLeftX botLeftY topRightX topRightY
+#define QUERY_KNN 2  // knn x y k
+#define QUERY_RADIUS 3  // radius x y metres
+
+// most values of a query
+#define QUERY_VALUES 4
+
+// header at the start of a binary query file
+typedef struct queryFileHeader {
+    unsigned int magic;
+    unsigned int version;
+    unsigned int valueSize;  // bytes of a long double where the file was written
+    unsigned int nQueries;  // records following the header
+    unsigned long long recordSize;  // bytes of a record where the file was written
+    unsigned long long textSize;  // bytes of the text of the values after the records
+} queryFileHeader_t;
+
+// query of a binary query file, values already parsed as the text format would be
+typedef struct queryRecord {
+    long double values[QUERY_VALUES];  // by type as in the text format, unused ones are 0
+    unsigned int text[QUERY_VALUES];  // offset of the text of every value, printed unchanged
+    int type;
+    int nValues;
+} queryRecord_t;
+
+// binary query file mapped into memory, read only
+typedef struct queryFile {
+    queryFileHeader_t* header;
+    queryRecord_t* records;
+    char* text;  // nul terminated text of every value, offsets are from here
+    size_t size;  // bytes mapped
+} queryFile_t;
+
+// converts the queries of text format `textFile`, one per line, to binary query file `path`
+// blank lines are skipped, returns the number of queries written, -1 if a line
+// is not a query or `path` can't be written, in which case nothing is written
+int queryFileConvert(FILE* textFile, char* path);
+
+// maps binary query file `path` into memory
+// returns NULL if `path` can't be read or isn't a query file written on this machine
+queryFile_t* queryFileOpen(char* path);
+
+// returns the text of value `value` of `record` of `queryFile`, as given in the text format
+char* queryFileText(queryFile_t* queryFile, queryRecord_t* record, int value);
+
+// unmaps `queryFile` and frees the memory used by it
+void queryFileClose(queryFile_t* queryFile);
+
+#endif
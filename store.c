@@ -0,0 +1,207 @@
+/* Project: PR QuadTrees
+* store.c :
+*            = implementation of the module store of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "store.h"
+#include "data.h"
+#include "dictionary.h"
+
+// bytes of every column of a row
+#define ROW_BYTES (9 * sizeof(double) + 10 * sizeof(int))
+
+// resizes every column of `store` to hold `size` rows
+static void storeResize(footpathStore_t* store, int size) {
+    store->size = size;
+    store->footpathID = realloc(store->footpathID, size * sizeof(*store->footpathID));
+    store->address = realloc(store->address, size * sizeof(*store->address));
+    store->clueSa = realloc(store->clueSa, size * sizeof(*store->clueSa));
+    store->assetType = realloc(store->assetType, size * sizeof(*store->assetType));
+    store->deltaZ = realloc(store->deltaZ, size * sizeof(*store->deltaZ));
+    store->distance = realloc(store->distance, size * sizeof(*store->distance));
+    store->grade1in = realloc(store->grade1in, size * sizeof(*store->grade1in));
+    store->mccID = realloc(store->mccID, size * sizeof(*store->mccID));
+    store->mccIDInt = realloc(store->mccIDInt, size * sizeof(*store->mccIDInt));
+    store->rlMax = realloc(store->rlMax, size * sizeof(*store->rlMax));
+    store->rlMin = realloc(store->rlMin, size * sizeof(*store->rlMin));
+    store->segSide = realloc(store->segSide, size * sizeof(*store->segSide));
+    store->statusID = realloc(store->statusID, size * sizeof(*store->statusID));
+    store->streetID = realloc(store->streetID, size * sizeof(*store->streetID));
+    store->streetGroup = realloc(store->streetGroup, size * sizeof(*store->streetGroup));
+    store->startLat = realloc(store->startLat, size * sizeof(*store->startLat));
+    store->startLon = realloc(store->startLon, size * sizeof(*store->startLon));
+    store->endLat = realloc(store->endLat, size * sizeof(*store->endLat));
+    store->endLon = realloc(store->endLon, size * sizeof(*store->endLon));
+    assert(store->footpathID && store->address && store->clueSa && store->assetType &&
+        store->deltaZ && store->distance && store->grade1in && store->mccID &&
+        store->mccIDInt && store->rlMax && store->rlMin && store->segSide &&
+        store->statusID && store->streetID && store->streetGroup && store->startLat &&
+        store->startLon && store->endLat && store->endLon);
+}
+
+// returns a footpath for the next row of `store`, from a new block if the last is used up
+static footpath_t* storeFootpath(footpathStore_t* store) {
+    if (store->nFree == 0) {
+        int size = store->n > STORE_INIT_SIZE ? store->n : STORE_INIT_SIZE;
+        store->blocks = realloc(store->blocks, (store->nBlocks + 1) * sizeof(*store->blocks));
+        assert(store->blocks);
+        store->blocks[store->nBlocks] = malloc(size * sizeof(**store->blocks));
+        assert(store->blocks[store->nBlocks]);
+        store->nBlocks++;
+        store->nFootpaths += size;
+        store->next = store->blocks[store->nBlocks - 1];
+        store->nFree = size;
+    }
+
+    store->nFree--;
+    return store->next++;
+}
+
+// creates and returns an empty store
+footpathStore_t* footpathStoreCreate() {
+    footpathStore_t* store = calloc(1, sizeof(*store));
+    assert(store);
+
+    storeResize(store, STORE_INIT_SIZE);
+
+    store->addresses = dictionaryCreate();
+    store->clueSas = dictionaryCreate();
+    store->assetTypes = dictionaryCreate();
+    store->segSides = dictionaryCreate();
+
+    return store;
+}
+
+// adds `record` to `store` as a new row, `record` isn't kept
+// returns the footpath of the row
+footpath_t* footpathStoreAdd(footpathStore_t* store, footpathRecord_t* record) {
+    if (store->n == store->size)
+        storeResize(store, 2 * store->size);
+
+    int row = store->n++;
+    store->footpathID[row] = record->footpathID;
+    store->address[row] = dictionaryEncode(store->addresses, record->address);
+    store->clueSa[row] = dictionaryEncode(store->clueSas, record->clueSa);
+    store->assetType[row] = dictionaryEncode(store->assetTypes, record->assetType);
+    store->deltaZ[row] = record->deltaZ;
+    store->distance[row] = record->distance;
+    store->grade1in[row] = record->grade1in;
+    store->mccID[row] = record->mccID;
+    store->mccIDInt[row] = record->mccIDInt;
+    store->rlMax[row] = record->rlMax;
+    store->rlMin[row] = record->rlMin;
+    store->segSide[row] = dictionaryEncode(store->segSides, record->segSide);
+    store->statusID[row] = record->statusID;
+    store->streetID[row] = record->streetID;
+    store->streetGroup[row] = record->streetGroup;
+    store->startLat[row] = record->startLat;
+    store->startLon[row] = record->startLon;
+    store->endLat[row] = record->endLat;
+    store->endLon[row] = record->endLon;
+
+    footpath_t* footpath = storeFootpath(store);
+    footpath->store = store;
+    footpath->row = row;
+    return footpath;
+}
+
+// adds the row of `footpath`, held by any store, to `store` as a new row
+// returns the footpath of the new row
+footpath_t* footpathStoreCopy(footpathStore_t* store, footpath_t* footpath) {
+    footpathRecord_t record;
+    footpathStoreGet(footpath->store, footpath->row, &record);
+    return footpathStoreAdd(store, &record);
+}
+
+// shrinks the columns of `store` to the rows stored once no more are added
+void footpathStoreShrink(footpathStore_t* store) {
+    storeResize(store, store->n > 0 ? store->n : 1);
+}
+
+// fills `record` with `row` of `store`, its strings belong to `store`
+void footpathStoreGet(footpathStore_t* store, int row, footpathRecord_t* record) {
+    assert(row >= 0 && row < store->n);
+
+    record->footpathID = store->footpathID[row];
+    record->address = dictionaryDecode(store->addresses, store->address[row]);
+    record->clueSa = dictionaryDecode(store->clueSas, store->clueSa[row]);
+    record->assetType = dictionaryDecode(store->assetTypes, store->assetType[row]);
+    record->deltaZ = store->deltaZ[row];
+    record->distance = store->distance[row];
+    record->grade1in = store->grade1in[row];
+    record->mccID = store->mccID[row];
+    record->mccIDInt = store->mccIDInt[row];
+    record->rlMax = store->rlMax[row];
+    record->rlMin = store->rlMin[row];
+    record->segSide = dictionaryDecode(store->segSides, store->segSide[row]);
+    record->statusID = store->statusID[row];
+    record->streetID = store->streetID[row];
+    record->streetGroup = store->streetGroup[row];
+    record->startLat = store->startLat[row];
+    record->startLon = store->startLon[row];
+    record->endLat = store->endLat[row];
+    record->endLon = store->endLon[row];
+}
+
+// returns footpathID of `row` of `store`
+int footpathStoreGetID(footpathStore_t* store, int row) {
+    return store->footpathID[row];
+}
+
+// prints `row` of `store` to `outFile` as footpathRecordPrint does
+void footpathStorePrint(footpathStore_t* store, int row, FILE* outFile) {
+    footpathRecord_t record;
+    footpathStoreGet(store, row, &record);
+    footpathRecordPrint(&record, outFile);
+}
+
+// returns the bytes of memory used by the columns and footpaths of `store`
+size_t footpathStoreColumnBytes(footpathStore_t* store) {
+    return sizeof(*store) + store->size * ROW_BYTES + store->nBlocks * sizeof(*store->blocks) +
+        store->nFootpaths * sizeof(**store->blocks);
+}
+
+// returns the bytes of memory used by the dictionaries of `store`
+size_t footpathStoreStringBytes(footpathStore_t* store) {
+    return dictionaryMemoryUsage(store->addresses) + dictionaryMemoryUsage(store->clueSas) +
+        dictionaryMemoryUsage(store->assetTypes) + dictionaryMemoryUsage(store->segSides);
+}
+
+// free allocated memory used by `store`
+void footpathStoreFree(footpathStore_t* store) {
+    free(store->footpathID);
+    free(store->address);
+    free(store->clueSa);
+    free(store->assetType);
+    free(store->deltaZ);
+    free(store->distance);
+    free(store->grade1in);
+    free(store->mccID);
+    free(store->mccIDInt);
+    free(store->rlMax);
+    free(store->rlMin);
+    free(store->segSide);
+    free(store->statusID);
+    free(store->streetID);
+    free(store->streetGroup);
+    free(store->startLat);
+    free(store->startLon);
+    free(store->endLat);
+    free(store->endLon);
+    for (int i = 0; i < store->nBlocks; i++)
+        free(store->blocks[i]);
+    free(store->blocks);
+    dictionaryFree(store->addresses);
+    dictionaryFree(store->clueSas);
+    dictionaryFree(store->assetTypes);
+    dictionaryFree(store->segSides);
+    free(store);
+}
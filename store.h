@@ -0,0 +1,87 @@
+/* Project: PR QuadTrees
+* store.h :
+*            = interface of the module store of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _STORE_H_
+#define _STORE_H_
+
+#include <stdio.h>
+
+#include "data.h"
+#include "dictionary.h"
+
+#define STORE_INIT_SIZE 64  // initial number of rows a store can hold
+
+// footpath records stored column by column and addressed by row,
+// strings are dictionary encoded so every distinct string is stored once
+// every row has one footpath_t referring to it, which never moves
+typedef struct footpathStore {
+    int n;  // rows in the store
+    int size;  // rows the store can hold before growing
+    int* footpathID;
+    int* address;  // codes of `addresses`
+    int* clueSa;  // codes of `clueSas`
+    int* assetType;  // codes of `assetTypes`
+    double* deltaZ;
+    double* distance;
+    double* grade1in;
+    int* mccID;
+    int* mccIDInt;
+    double* rlMax;
+    double* rlMin;
+    int* segSide;  // codes of `segSides`
+    int* statusID;
+    int* streetID;
+    int* streetGroup;
+    double* startLat;
+    double* startLon;
+    double* endLat;
+    double* endLon;
+    dictionary_t* addresses;
+    dictionary_t* clueSas;
+    dictionary_t* assetTypes;
+    dictionary_t* segSides;
+    footpath_t** blocks;  // footpaths of the rows, a block is never moved once allocated
+    int nBlocks;
+    int nFootpaths;  // footpaths in every block, used or not
+    footpath_t* next;  // next footpath of the last block to give to a row
+    int nFree;  // footpaths from `next` to the end of the last block
+} footpathStore_t;
+
+// creates and returns an empty store
+footpathStore_t* footpathStoreCreate();
+
+// adds `record` to `store` as a new row, `record` isn't kept
+// returns the footpath of the row
+footpath_t* footpathStoreAdd(footpathStore_t* store, footpathRecord_t* record);
+
+// adds the row of `footpath`, held by any store, to `store` as a new row
+// returns the footpath of the new row
+footpath_t* footpathStoreCopy(footpathStore_t* store, footpath_t* footpath);
+
+// shrinks the columns of `store` to the rows stored once no more are added
+void footpathStoreShrink(footpathStore_t* store);
+
+// fills `record` with `row` of `store`, its strings belong to `store`
+void footpathStoreGet(footpathStore_t* store, int row, footpathRecord_t* record);
+
+// returns footpathID of `row` of `store`
+int footpathStoreGetID(footpathStore_t* store, int row);
+
+// prints `row` of `store` to `outFile` as footpathRecordPrint does
+void footpathStorePrint(footpathStore_t* store, int row, FILE* outFile);
+
+// returns the bytes of memory used by the columns and footpaths of `store`
+size_t footpathStoreColumnBytes(footpathStore_t* store);
+
+// returns the bytes of memory used by the dictionaries of `store`
+size_t footpathStoreStringBytes(footpathStore_t* store);
+
+// free allocated memory used by `store`
+void footpathStoreFree(footpathStore_t* store);
+
+#endif
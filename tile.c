@@ -0,0 +1,530 @@
+/* Project: PR QuadTrees
+* tile.c :
+*            = implementation of the module tile of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "tile.h"
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+
+// returns the malloc'd path of `name` inside `directory`
+static char* tilePath(char* directory, char* name) {
+    char* path = malloc(strlen(directory) + strlen(name) + 2);
+    assert(path);
+    sprintf(path, "%s/%s", directory, name);
+    return path;
+}
+
+// returns the malloc'd path of the file storing tile `i` of `directory`
+static char* tileFileName(char* directory, int i) {
+    char name[MAX_CHARS + 1];
+    sprintf(name, "tile_%d.bin", i);
+    return tilePath(directory, name);
+}
+
+// returns the span of the tile in `row` and `col` of `rectangle` split `level` times
+// halves the span exactly as splitNode does so tiles match quadrants of the tree
+static rectangle_t* tileRectangle(rectangle_t* rectangle, int level, int row, int col) {
+    long double botLeftX = rectangle->botLeftX, botLeftY = rectangle->botLeftY;
+    long double topRightX = rectangle->topRightX, topRightY = rectangle->topRightY;
+
+    for (int bit = level - 1; bit >= 0; bit--) {
+        long double middleX = (botLeftX + topRightX) / 2;
+        long double middleY = (botLeftY + topRightY) / 2;
+
+        if ((col >> bit) & 1)
+            botLeftX = middleX;
+        else
+            topRightX = middleX;
+
+        if ((row >> bit) & 1)
+            botLeftY = middleY;
+        else
+            topRightY = middleY;
+    }
+    return newRectangle(botLeftX, botLeftY, topRightX, topRightY);
+}
+
+// returns the malloc'd quadrant codes from the root region to the tile
+// in `row` and `col` of a region split `level` times
+static unsigned char* tileQuadrants(int level, int row, int col) {
+    unsigned char* path = malloc(level + 1);
+    assert(path);
+
+    for (int bit = level - 1; bit >= 0; bit--) {
+        int north = (row >> bit) & 1;
+        int east = (col >> bit) & 1;
+        // codes as returned by findQuadrant, NW 0, NE 1, SW 2 and SE 3
+        path[level - 1 - bit] = (north ? 0 : 2) + east;
+    }
+    return path;
+}
+
+// returns the index of the tile `point` belongs in within `rectangle` split
+// `level` times, -1 if outside `rectangle`
+static int tileLocateIn(rectangle_t* rectangle, int level, point_t* point) {
+    if (!inRectangle(rectangle, point))
+        return -1;
+
+    long double botLeftX = rectangle->botLeftX, botLeftY = rectangle->botLeftY;
+    long double topRightX = rectangle->topRightX, topRightY = rectangle->topRightY;
+    int row = 0, col = 0;
+
+    // same comparisons as findQuadrant at every level
+    for (int i = 0; i < level; i++) {
+        long double middleX = (botLeftX + topRightX) / 2;
+        long double middleY = (botLeftY + topRightY) / 2;
+
+        col <<= 1;
+        if (point->x <= middleX) {
+            topRightX = middleX;
+        } else {
+            botLeftX = middleX;
+            col |= 1;
+        }
+
+        row <<= 1;
+        if (point->y >= middleY) {
+            botLeftY = middleY;
+            row |= 1;
+        } else {
+            topRightY = middleY;
+        }
+    }
+    return row * (1 << level) + col;
+}
+
+// returns the index of the tile `point` belongs in, -1 if outside the root region
+int tileLocate(tileIndex_t* index, point_t* point) {
+    return tileLocateIn(index->rectangle, index->level, point);
+}
+
+// stores the identity of csv `dataFile` into `source`
+// returns 0 if `dataFile` can't be read, 1 otherwise
+static int tileSourceOf(char* dataFile, tileSource_t* source) {
+    struct stat st;
+    if (stat(dataFile, &st) != 0)
+        return 0;
+
+    memset(source, 0, sizeof(*source));
+    source->size = st.st_size;
+    source->modified = st.st_mtim.tv_sec;
+    source->modifiedNsec = st.st_mtim.tv_nsec;
+    return 1;
+}
+
+// returns whether rectangles `a` and `b` span the same region
+static int tileSameRectangle(rectangle_t* a, rectangle_t* b) {
+    return a->botLeftX == b->botLeftX && a->botLeftY == b->botLeftY &&
+        a->topRightX == b->topRightX && a->topRightY == b->topRightY;
+}
+
+// appends the serialized footpaths in `buffers` to the tile files and empties them
+static void tileFlush(char* directory, FILE** buffers, char** data, size_t* sizes, int nTiles) {
+    for (int i = 0; i < nTiles; i++) {
+        fflush(buffers[i]);
+        if (sizes[i] == 0)
+            continue;
+
+        char* fileName = tileFileName(directory, i);
+        FILE* f = fopen(fileName, "ab");
+        assert(f);
+        fwrite(data[i], 1, sizes[i], f);
+        fclose(f);
+        free(fileName);
+
+        rewind(buffers[i]);
+        sizes[i] = 0;
+    }
+}
+
+// splits the footpaths of csv `dataFile` into 4^`level` tiles of `rectangle`
+// and writes every tile as an independent file into `directory`
+void tileIndexBuild(char* dataFile, char* directory, rectangle_t* rectangle, int level) {
+    assert(level >= 0 && level <= MAX_TILE_LEVEL);
+    int nTiles = 1 << (2 * level);
+
+    FILE* inFile = fopen(dataFile, "r");
+    assert(inFile);
+
+    // `dataFile` was just opened so its identity can be read
+    tileSource_t source;
+    if (!tileSourceOf(dataFile, &source)) {
+        fprintf(stderr, "cannot read the size of %s\n", dataFile);
+        exit(EXIT_FAILURE);
+    }
+
+    if (mkdir(directory, 0755) != 0)
+        assert(errno == EEXIST);
+
+    // footpaths are serialized into memory and appended to the
+    // tile files in batches to keep the number of open files small
+    FILE** buffers = malloc(nTiles * sizeof(*buffers));
+    char** data = malloc(nTiles * sizeof(*data));
+    size_t* sizes = malloc(nTiles * sizeof(*sizes));
+    int* nRecords = calloc(nTiles, sizeof(*nRecords));
+    assert(buffers && data && sizes && nRecords);
+
+    for (int i = 0; i < nTiles; i++) {
+        // truncating tile files from an earlier build
+        char* fileName = tileFileName(directory, i);
+        FILE* f = fopen(fileName, "wb");
+        assert(f);
+        fclose(f);
+        free(fileName);
+
+        buffers[i] = open_memstream(&data[i], &sizes[i]);
+        assert(buffers[i]);
+    }
+
+    footpathSkipHeaderLine(inFile);
+
+    // variables needed for getline function
+    char *linePtr = NULL;
+    size_t len = 0;
+    size_t buffered = 0;
+
+    while (getline(&linePtr, &len, inFile) != -1) {
+        footpathRecord_t* footpath = footpathRead(linePtr);
+
+        point_t start = {footpath->startLon, footpath->startLat};
+        point_t end = {footpath->endLon, footpath->endLat};
+        int startTile = tileLocateIn(rectangle, level, &start);
+        int endTile = tileLocateIn(rectangle, level, &end);
+
+        // footpath is stored in every tile one of its points is in
+        if (startTile != -1) {
+            buffered += footpathWrite(footpath, buffers[startTile]);
+            nRecords[startTile]++;
+        }
+        if (endTile != -1 && endTile != startTile) {
+            buffered += footpathWrite(footpath, buffers[endTile]);
+            nRecords[endTile]++;
+        }
+        footpathRecordFree(footpath);
+
+        if (buffered > TILE_WRITE_BUFFER) {
+            tileFlush(directory, buffers, data, sizes, nTiles);
+            buffered = 0;
+        }
+    }
+    tileFlush(directory, buffers, data, sizes, nTiles);
+
+    // writing directory describing the tiles
+    char* directoryFile = tilePath(directory, TILE_DIRECTORY_FILE);
+    FILE* f = fopen(directoryFile, "wb");
+    assert(f);
+    fwrite(&source, sizeof(source), 1, f);
+    fwrite(rectangle, sizeof(*rectangle), 1, f);
+    fwrite(&level, sizeof(level), 1, f);
+    fwrite(nRecords, sizeof(*nRecords), nTiles, f);
+    fclose(f);
+    free(directoryFile);
+
+    for (int i = 0; i < nTiles; i++) {
+        fclose(buffers[i]);
+        free(data[i]);
+    }
+    free(buffers);
+    free(data);
+    free(sizes);
+    free(nRecords);
+    free(linePtr);
+    fclose(inFile);
+}
+
+// opens the tiles written to `directory` by tileIndexBuild from csv `dataFile`
+// split `level` times below `rectangle`
+// at most `budget` bytes of tiles are kept in memory between queries
+// returns NULL if `directory` holds no complete directory file or its tiles were
+// built from another data file, rectangle or level, or `dataFile` changed since
+tileIndex_t* tileIndexOpen(char* directory, char* dataFile, rectangle_t* rectangle,
+                            int level, size_t budget) {
+    tileSource_t source;
+    if (!tileSourceOf(dataFile, &source))
+        return NULL;
+
+    char* directoryFile = tilePath(directory, TILE_DIRECTORY_FILE);
+    FILE* f = fopen(directoryFile, "rb");
+    free(directoryFile);
+    if (f == NULL)
+        return NULL;
+
+    tileSource_t builtSource;
+    rectangle_t builtRectangle;
+    int builtLevel;
+    if (fread(&builtSource, sizeof(builtSource), 1, f) != 1 ||
+        fread(&builtRectangle, sizeof(builtRectangle), 1, f) != 1 ||
+        fread(&builtLevel, sizeof(builtLevel), 1, f) != 1 ||
+        memcmp(&builtSource, &source, sizeof(source)) != 0 ||
+        !tileSameRectangle(&builtRectangle, rectangle) || builtLevel != level ||
+        level < 0 || level > MAX_TILE_LEVEL) {
+        fclose(f);
+        return NULL;
+    }
+
+    int tilesPerSide = 1 << level;
+    int nTiles = tilesPerSide * tilesPerSide;
+    int* nRecords = malloc(nTiles * sizeof(*nRecords));
+    assert(nRecords);
+    size_t nRead = fread(nRecords, sizeof(*nRecords), nTiles, f);
+    fclose(f);
+    if (nRead != (size_t)nTiles) {
+        free(nRecords);
+        return NULL;
+    }
+
+    tileIndex_t* index = malloc(sizeof(*index));
+    assert(index);
+
+    index->rectangle = newRectangle(rectangle->botLeftX, rectangle->botLeftY,
+                                    rectangle->topRightX, rectangle->topRightY);
+    index->level = level;
+    index->directory = strdup(directory);
+    index->tilesPerSide = tilesPerSide;
+    index->budget = budget;
+    index->used = 0;
+    index->epoch = 0;
+    index->head = NULL;
+    index->tail = NULL;
+
+    index->tiles = malloc(nTiles * sizeof(*index->tiles));
+    assert(index->tiles);
+
+    for (int i = 0; i < nTiles; i++) {
+        tile_t* tile = &index->tiles[i];
+        tile->nRecords = nRecords[i];
+        tile->rectangle = tileRectangle(index->rectangle, index->level,
+                                        i / index->tilesPerSide, i % index->tilesPerSide);
+        tile->path = tileQuadrants(index->level, i / index->tilesPerSide, i % index->tilesPerSide);
+        tile->qTree = NULL;
+        tile->bytes = 0;
+        tile->epoch = -1;
+        tile->prev = NULL;
+        tile->next = NULL;
+    }
+    free(nRecords);
+
+    return index;
+}
+
+// unlinks `tile` from the list of tiles in memory
+static void tileUnlink(tileIndex_t* index, tile_t* tile) {
+    if (tile->prev)
+        tile->prev->next = tile->next;
+    else
+        index->head = tile->next;
+
+    if (tile->next)
+        tile->next->prev = tile->prev;
+    else
+        index->tail = tile->prev;
+
+    tile->prev = NULL;
+    tile->next = NULL;
+}
+
+// links `tile` as the most recently used tile in memory
+static void tilePushFront(tileIndex_t* index, tile_t* tile) {
+    tile->prev = NULL;
+    tile->next = index->head;
+    if (index->head)
+        index->head->prev = tile;
+    index->head = tile;
+    if (index->tail == NULL)
+        index->tail = tile;
+}
+
+// removes `tile` from memory
+void tileEvict(tileIndex_t* index, tile_t* tile) {
+    if (tile->qTree == NULL)
+        return;
+
+    tileUnlink(index, tile);
+    qTreeFree(tile->qTree);
+    tile->qTree = NULL;
+    index->used -= tile->bytes;
+    tile->bytes = 0;
+}
+
+// evicts least recently used tiles until `bytes` more fit in the budget
+// tiles used by the current query hold footpaths of its results so are kept
+static void tileMakeRoom(tileIndex_t* index, size_t bytes) {
+    tile_t* tile = index->tail;
+    while (tile && index->used + bytes > index->budget) {
+        tile_t* prev = tile->prev;
+        if (tile->epoch != index->epoch)
+            tileEvict(index, tile);
+        tile = prev;
+    }
+}
+
+// returns the sub-tree of `tile`, reading it from disk if not in memory
+qTree_t* tileLoad(tileIndex_t* index, tile_t* tile) {
+    tile->epoch = index->epoch;
+
+    if (tile->qTree) {
+        tileUnlink(index, tile);
+        tilePushFront(index, tile);
+        return tile->qTree;
+    }
+
+    int i = tile - index->tiles;
+    char* fileName = tileFileName(index->directory, i);
+    FILE* f = fopen(fileName, "rb");
+    assert(f);
+    free(fileName);
+
+    rectangle_t* rectangle = newRectangle(tile->rectangle->botLeftX, tile->rectangle->botLeftY,
+                                    tile->rectangle->topRightX, tile->rectangle->topRightY);
+    qTree_t* qTree = qTreeCreate(rectangle, footpathStoreCreate());
+
+    // root of the sub-tree is the last quadrant leading to the tile
+    qTree->root->quadrant = index->level > 0 ? tile->path[index->level - 1] : NO_QUADRANT;
+
+    footpathRecord_t* record;
+    while ((record = footpathReadBinary(f)) != NULL) {
+        point_t* startPoint = newPoint(record->startLon, record->startLat);
+        point_t* endPoint = newPoint(record->endLon, record->endLat);
+        int startInTile = tileLocate(index, startPoint) == i;
+        int endInTile = tileLocate(index, endPoint) == i;
+
+        // only points within the tile belong in its sub-tree, sharing one row
+        footpath_t* footpath = NULL;
+        if (startInTile || endInTile)
+            footpath = footpathStoreAdd(qTree->store, record);
+
+        if (startInTile)
+            qTreeInsert(qTree, startPoint, footpath);
+        else
+            free(startPoint);
+
+        if (endInTile)
+            qTreeInsert(qTree, endPoint, footpath);
+        else
+            free(endPoint);
+
+        footpathRecordFree(record);
+    }
+    fclose(f);
+
+    // tiles are never inserted into once loaded
+    qTreeFinalize(qTree);
+    qTreeFreeze(qTree);
+
+    qTreeMemory_t memory;
+    qTreeMemoryUsage(qTree, &memory);
+    tile->bytes = qTreeMemoryTotal(&memory);
+    tileMakeRoom(index, tile->bytes);
+
+    tile->qTree = qTree;
+    index->used += tile->bytes;
+    tilePushFront(index, tile);
+
+    return qTree;
+}
+
+// returns the number of tiles holding footpaths below the node `depth` splits below
+// the root region in `row` and `col`, storing one of them into `found`
+static int tileBlockTiles(tileIndex_t* index, int depth, int row, int col, tile_t** found) {
+    int side = 1 << (index->level - depth);
+    int nTiles = 0;
+    for (int i = row * side; i < (row + 1) * side; i++) {
+        for (int j = col * side; j < (col + 1) * side; j++) {
+            tile_t* tile = &index->tiles[i * index->tilesPerSide + j];
+            if (tile->nRecords > 0) {
+                *found = tile;
+                nTiles++;
+            }
+        }
+    }
+    return nTiles;
+}
+
+// searches the tiles below the node `depth` splits below the root region in `row`
+// and `col` for points within `range` as queryRange searches the whole tree
+// nodes above the tiles are traced and visited in the order queryRange visits the
+// nodes of the whole tree, SW, NW, NE then SE, down to where the whole tree would
+// stop splitting as the tiles below hold a single point
+static void tileRangeNode(tileIndex_t* index, int depth, int row, int col, rectangle_t* range,
+                        array_t* footpathVisited, trace_t* trace, array_t* results) {
+    tile_t* tile = NULL;
+    int nTiles = tileBlockTiles(index, depth, row, col, &tile);
+    if (nTiles == 0)
+        return;
+
+    // the root of the sub-tree of a tile is traced as the quadrant of the tile
+    if (depth == index->level) {
+        qTreeRange(tileLoad(index, tile), range, footpathVisited, trace, results);
+        return;
+    }
+
+    rectangle_t* span = tileRectangle(index->rectangle, depth, row, col);
+    // codes as returned by findQuadrant, NW 0, NE 1, SW 2 and SE 3
+    int quadrant = depth == 0 ? NO_QUADRANT : ((row & 1) ? 0 : 2) + (col & 1);
+
+    if (!rectangleOverlap(span, range)) {
+        free(span);
+        return;
+    }
+
+    // a single point below the node makes it a leaf of the whole tree
+    qTree_t* qTree = nTiles == 1 ? tileLoad(index, tile) : NULL;
+    if (qTree != NULL && qTree->root->NW == NULL) {
+        qTreeNode_t leaf = *qTree->root;
+        leaf.rectangle = span;
+        leaf.quadrant = quadrant;
+        queryRange(&leaf, range, footpathVisited, trace, results);
+        free(span);
+        return;
+    }
+    free(span);
+
+    traceAppend(trace, quadrant);
+
+    // north and east halves of the children in the order queryRange visits them
+    static const int order[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    for (int i = 0; i < 4; i++)
+        tileRangeNode(index, depth + 1, 2 * row + order[i][0], 2 * col + order[i][1], range,
+                        footpathVisited, trace, results);
+}
+
+// searches all tiles overlapping `range` for points within `range`
+// stores unique footpaths of those points and direction as queryRange does,
+// tracing the quadrants above the tiles once each as if the tiles were one tree
+// footpaths in `results` stay valid until the next query on `index`
+array_t* tileIndexRange(tileIndex_t* index, rectangle_t* range,
+                        array_t* footpathVisited, trace_t* trace, array_t* results) {
+    // tiles used by the previous query may now be evicted
+    index->epoch++;
+
+    // results of every tile are merged into `results`,
+    // `footpathVisited` removes footpaths stored in several tiles
+    tileRangeNode(index, 0, 0, 0, range, footpathVisited, trace, results);
+    return results;
+}
+
+// free allocated memory used by `index`, tile files are kept
+void tileIndexFree(tileIndex_t* index) {
+    int nTiles = index->tilesPerSide * index->tilesPerSide;
+    for (int i = 0; i < nTiles; i++) {
+        tileEvict(index, &index->tiles[i]);
+        free(index->tiles[i].rectangle);
+        free(index->tiles[i].path);
+    }
+    free(index->tiles);
+    free(index->rectangle);
+    free(index->directory);
+    free(index);
+}
@@ -0,0 +1,95 @@
+/* Project: PR QuadTrees
+* tile.h :
+*            = interface of the module tile of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _TILE_H_
+#define _TILE_H_
+
+#include <stdio.h>
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+#include "trace.h"
+
+// name of the file in a tile directory that describes its tiles
+#define TILE_DIRECTORY_FILE "directory.bin"
+
+// tiles are the quadrants `level` splits below the root, so the
+// maximum level bounds the directory at 4^MAX_TILE_LEVEL tiles
+#define MAX_TILE_LEVEL 8
+
+// bytes of serialized footpaths kept in memory per build before
+// they are appended to the tile files
+#define TILE_WRITE_BUFFER (16 * 1024 * 1024)
+
+// identity of the data file a tile directory was built from, a directory
+// built from another file, or this one since changed, is built again
+typedef struct tileSource {
+    long long size;  // bytes of the data file
+    long long modified;  // seconds of the last modification of the data file
+    long long modifiedNsec;  // nanoseconds of the last modification
+} tileSource_t;
+
+// a tile of the root region, stored on disk as an independent sub-tree
+typedef struct tile {
+    rectangle_t* rectangle;  // span of the tile
+    unsigned char* path;  // `level` quadrant codes from the root region to the tile
+    int nRecords;  // number of footpaths stored in the tile file
+    qTree_t* qTree;  // sub-tree of the tile, NULL when not in memory
+    size_t bytes;  // memory used by `qTree` while in memory
+    int epoch;  // last query that used the tile
+    struct tile *prev;  // more recently used tile in memory
+    struct tile *next;  // less recently used tile in memory
+} tile_t;
+
+// in-memory directory routing queries to tiles paged in on demand
+typedef struct tileIndex {
+    char* directory;  // directory containing the tile files
+    rectangle_t* rectangle;  // span of the root region
+    int level;  // tiles are `level` quadrant splits below the root
+    int tilesPerSide;  // 2^level
+    tile_t* tiles;  // tilesPerSide * tilesPerSide tiles, row major from bottom left
+    size_t budget;  // maximum bytes of tiles to keep in memory
+    size_t used;  // bytes of tiles currently in memory
+    int epoch;  // number of queries run so far
+    tile_t* head;  // most recently used tile in memory
+    tile_t* tail;  // least recently used tile in memory
+} tileIndex_t;
+
+// splits the footpaths of csv `dataFile` into 4^`level` tiles of `rectangle`
+// and writes every tile as an independent file into `directory`
+void tileIndexBuild(char* dataFile, char* directory, rectangle_t* rectangle, int level);
+
+// opens the tiles written to `directory` by tileIndexBuild from csv `dataFile`
+// split `level` times below `rectangle`
+// at most `budget` bytes of tiles are kept in memory between queries
+// returns NULL if `directory` holds no complete directory file or its tiles were
+// built from another data file, rectangle or level, or `dataFile` changed since
+tileIndex_t* tileIndexOpen(char* directory, char* dataFile, rectangle_t* rectangle,
+                            int level, size_t budget);
+
+// returns the index of the tile `point` belongs in, -1 if outside the root region
+int tileLocate(tileIndex_t* index, point_t* point);
+
+// searches all tiles overlapping `range` for points within `range`
+// stores unique footpaths of those points and direction as queryRange does,
+// tracing the quadrants above the tiles once each as if the tiles were one tree
+// footpaths in `results` stay valid until the next query on `index`
+array_t* tileIndexRange(tileIndex_t* index, rectangle_t* range,
+                        array_t* footpathVisited, trace_t* trace, array_t* results);
+
+// returns the sub-tree of `tile`, reading it from disk if not in memory
+qTree_t* tileLoad(tileIndex_t* index, tile_t* tile);
+
+// removes `tile` from memory
+void tileEvict(tileIndex_t* index, tile_t* tile);
+
+// free allocated memory used by `index`, tile files are kept
+void tileIndexFree(tileIndex_t* index);
+
+#endif
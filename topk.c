@@ -0,0 +1,195 @@
+/* Project: PR QuadTrees
+* topk.c :
+*            = implementation of the module topk of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "topk.h"
+#include "quadtree.h"
+#include "array.h"
+#include "filter.h"
+
+// node of the frontier of a top k query with the best value below it
+typedef struct topKNode {
+    double bound;
+    qTreeNode_t* node;
+} topKNode_t;
+
+// footpath kept by a top k query with its value, larger is better
+typedef struct topKFootpath {
+    double value;
+    footpath_t* footpath;
+} topKFootpath_t;
+
+// returns whether `a` is better than `b`, ties going to the lower ID
+static int topKBetter(topKFootpath_t* a, topKFootpath_t* b) {
+    if (a->value != b->value)
+        return a->value > b->value;
+    return footpathGetID(a->footpath) < footpathGetID(b->footpath);
+}
+
+// pushes `node` with `bound` onto max heap `frontier` of `n` nodes with room for `size`
+static void topKPush(topKNode_t** frontier, int* n, int* size, qTreeNode_t* node, double bound) {
+    if (*n == *size) {
+        *size *= 2;
+        *frontier = realloc(*frontier, *size * sizeof(**frontier));
+        assert(*frontier);
+    }
+
+    topKNode_t* heap = *frontier;
+    int i = (*n)++;
+    for (; i > 0 && heap[(i - 1) / 2].bound < bound; i = (i - 1) / 2)
+        heap[i] = heap[(i - 1) / 2];
+    heap[i] = (topKNode_t){bound, node};
+}
+
+// removes and returns the node with the best bound from max heap `frontier` of `n` nodes
+static topKNode_t topKPop(topKNode_t* frontier, int* n) {
+    topKNode_t top = frontier[0];
+    topKNode_t last = frontier[--(*n)];
+
+    int i = 0;
+    while (2 * i + 1 < *n) {
+        int child = 2 * i + 1;
+        if (child + 1 < *n && frontier[child + 1].bound > frontier[child].bound)
+            child++;
+        if (frontier[child].bound <= last.bound)
+            break;
+        frontier[i] = frontier[child];
+        i = child;
+    }
+    frontier[i] = last;
+    return top;
+}
+
+// moves the entry at `i` of heap `kept` of `n` footpaths, worst at the root, down to its place
+static void topKSiftDown(topKFootpath_t* kept, int n, int i) {
+    topKFootpath_t entry = kept[i];
+    while (2 * i + 1 < n) {
+        int child = 2 * i + 1;
+        if (child + 1 < n && topKBetter(&kept[child], &kept[child + 1]))
+            child++;
+        if (!topKBetter(&entry, &kept[child]))
+            break;
+        kept[i] = kept[child];
+        i = child;
+    }
+    kept[i] = entry;
+}
+
+// offers `candidate` to heap `kept` of `n` of at most `k` footpaths, worst at the root
+// a footpath already kept through its other point is not kept twice
+static void topKOffer(topKFootpath_t* kept, int* n, int k, topKFootpath_t* candidate) {
+    if (*n == k && !topKBetter(candidate, &kept[0]))
+        return;
+
+    for (int i = 0; i < *n; i++) {
+        if (footpathGetID(kept[i].footpath) == footpathGetID(candidate->footpath))
+            return;
+    }
+
+    if (*n < k) {
+        // moving up from the last leaf of the heap
+        int i = (*n)++;
+        for (; i > 0 && topKBetter(&kept[(i - 1) / 2], candidate); i = (i - 1) / 2)
+            kept[i] = kept[(i - 1) / 2];
+        kept[i] = *candidate;
+    } else {
+        kept[0] = *candidate;
+        topKSiftDown(kept, *n, 0);
+    }
+}
+
+// returns the best value of `attribute` below `node` by its summary, larger is better
+static double topKBound(qTreeNode_t* node, int attribute, int order) {
+    return order == TOPK_LARGEST ? node->summary->max[attribute] : -node->summary->min[attribute];
+}
+
+// returns whether `node` holds points and its span overlaps `range`, borders included
+static int topKOverlaps(qTreeNode_t* node, rectangle_t* range) {
+    rectangle_t* span = node->rectangle;
+    return node->count > 0 && span->topRightX >= range->botLeftX && span->botLeftX <= range->topRightX &&
+        span->topRightY >= range->botLeftY && span->botLeftY <= range->topRightY;
+}
+
+// searches `qTree` for the `k` footpaths with a point within `range` with the
+// largest or smallest, by `order`, numeric `attribute`, ties going to the lower ID
+// nodes are visited best bound first by the summaries of the attribute index,
+// built on first use, stopping once no node left can beat the `k`th footpath found
+// stores the footpaths best first into `results` and what the query cost into `stats`
+array_t* qTreeRangeTopK(qTree_t* qTree, rectangle_t* range, int attribute, int k, int order,
+                        topKStats_t* stats, array_t* results) {
+    memset(stats, 0, sizeof(*stats));
+    if (k <= 0)
+        return results;
+    if (qTree->attributes == NULL)
+        attributeIndexBuild(qTree);
+
+    topKFootpath_t* kept = malloc(k * sizeof(*kept));
+    int nKept = 0;
+    int size = TOPK_INIT_SIZE, n = 0;
+    topKNode_t* frontier = malloc(size * sizeof(*frontier));
+    assert(kept && frontier);
+
+    if (topKOverlaps(qTree->root, range))
+        topKPush(&frontier, &n, &size, qTree->root, topKBound(qTree->root, attribute, order));
+
+    while (n > 0) {
+        topKNode_t top = topKPop(frontier, &n);
+
+        // every node left is bounded by `top`, so none of them can do better than
+        // the worst footpath kept, a tie could still win on ID
+        if (nKept == k && kept[0].value > top.bound)
+            break;
+
+        qTreeNode_t* node = top.node;
+        stats->nodesVisited++;
+
+        if (node->point != NULL) {
+            if (!inRectangleStage4(range, node->point))
+                continue;
+
+            for (int i = 0; i < node->footpaths->n; i++) {
+                double value = footpathNumericAttribute(node->footpaths->A[i], attribute);
+                topKFootpath_t candidate = {order == TOPK_LARGEST ? value : -value,
+                                            node->footpaths->A[i]};
+                stats->footpathsTested++;
+                topKOffer(kept, &nKept, k, &candidate);
+            }
+            continue;
+        }
+
+        for (int quadrant = 0; node->NW != NULL && quadrant < 4; quadrant++) {
+            qTreeNode_t* child = getQuadrant(node, quadrant);
+            if (topKOverlaps(child, range))
+                topKPush(&frontier, &n, &size, child, topKBound(child, attribute, order));
+        }
+    }
+
+    // the heap empties worst first, so footpaths are placed from the back
+    int first = results->n;
+    for (int i = 0; i < nKept; i++)
+        arrayAppend(results, NULL);
+    while (nKept > 0) {
+        results->A[first + nKept - 1] = kept[0].footpath;
+        kept[0] = kept[--nKept];
+        topKSiftDown(kept, nKept, 0);
+    }
+
+    free(kept);
+    free(frontier);
+    return results;
+}
+
+// prints `stats` to `outFile`
+void topKStatsPrint(topKStats_t* stats, FILE* outFile) {
+    fprintf(outFile, "nodes visited: %d || footpaths tested: %d\n",
+            stats->nodesVisited, stats->footpathsTested);
+}
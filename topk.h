@@ -0,0 +1,42 @@
+/* Project: PR QuadTrees
+* topk.h :
+*            = interface of the module topk of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _TOPK_H_
+#define _TOPK_H_
+
+#include <stdio.h>
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+
+// which end of a numeric attribute a top k query keeps
+#define TOPK_LARGEST 0
+#define TOPK_SMALLEST 1
+
+// initial number of nodes the frontier of a top k query has room for
+#define TOPK_INIT_SIZE 64
+
+// what a top k query cost
+typedef struct topKStats {
+    int nodesVisited;  // nodes taken off the frontier
+    int footpathsTested;  // footpaths compared against the best found so far
+} topKStats_t;
+
+// searches `qTree` for the `k` footpaths with a point within `range` with the
+// largest or smallest, by `order`, numeric `attribute`, ties going to the lower ID
+// nodes are visited best bound first by the summaries of the attribute index,
+// built on first use, stopping once no node left can beat the `k`th footpath found
+// stores the footpaths best first into `results` and what the query cost into `stats`
+array_t* qTreeRangeTopK(qTree_t* qTree, rectangle_t* range, int attribute, int k, int order,
+                        topKStats_t* stats, array_t* results);
+
+// prints `stats` to `outFile`
+void topKStatsPrint(topKStats_t* stats, FILE* outFile);
+
+#endif
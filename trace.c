@@ -0,0 +1,82 @@
+/* Project: PR QuadTrees
+* trace.c :
+*            = implementation of the module trace of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "trace.h"
+
+// labels of quadrant codes, NO_QUADRANT being the root
+static char* quadrantLabels[] = {"NW", "NE", "SW", "SE", ""};
+
+// labels of octant codes, NO_OCTANT being the root
+static char* octantLabels[] = {"UNW", "UNE", "USW", "USE", "DNW", "DNE", "DSW", "DSE", ""};
+
+// creates and returns an empty trace
+trace_t* traceCreate() {
+    trace_t* trace = malloc(sizeof(*trace));
+    assert(trace);
+
+    trace->size = TRACE_INIT_SIZE;
+    trace->codes = malloc(trace->size * sizeof(*trace->codes));
+    assert(trace->codes);
+    trace->n = 0;
+
+    return trace;
+}
+
+// appends quadrant `code` to `trace`, does nothing if `trace` is NULL
+void traceAppend(trace_t* trace, int code) {
+    if (trace == NULL)
+        return;
+
+    if (trace->n == trace->size) {
+        trace->size <<= 1;
+        trace->codes = realloc(trace->codes, trace->size * sizeof(*trace->codes));
+        assert(trace->codes);
+    }
+    trace->codes[trace->n++] = code;
+}
+
+// empties `trace` keeping its buffer so it can be reused by the next query
+void traceReset(trace_t* trace) {
+    trace->n = 0;
+}
+
+// returns the label of quadrant `code`
+char* quadrantLabel(int code) {
+    return quadrantLabels[code];
+}
+
+// prints the codes in `trace` to `outFile` as their `labels`, separated by spaces
+static void tracePrintLabels(trace_t* trace, char** labels, FILE* outFile) {
+    for (int i = 0; i < trace->n - 1; i++) {
+        fputs(labels[trace->codes[i]], outFile);
+        fputc(' ', outFile);
+    }
+    if (trace->n > 0)
+        fputs(labels[trace->codes[trace->n - 1]], outFile);
+    fputc('\n', outFile);
+}
+
+// function to print the labels of the quadrants in `trace` to `outFile`
+void tracePrint(trace_t* trace, FILE* outFile) {
+    tracePrintLabels(trace, quadrantLabels, outFile);
+}
+
+// function to print the labels of the octants in `trace` to `outFile`
+void tracePrintOctants(trace_t* trace, FILE* outFile) {
+    tracePrintLabels(trace, octantLabels, outFile);
+}
+
+// function to free allocated memory used by `trace`
+void traceFree(trace_t* trace) {
+    free(trace->codes);
+    free(trace);
+}
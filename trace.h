@@ -0,0 +1,53 @@
+/* Project: PR QuadTrees
+* trace.h :
+*            = interface of the module trace of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stdio.h>
+
+// quadrant codes 0,1,2 and 3 are NW, NE, SW and SE as returned by findQuadrant
+// the root isn't in any quadrant and is printed as an empty label
+#define NO_QUADRANT 4
+
+// octant codes 0 to 7 are the quadrants NW, NE, SW and SE of the upper half then
+// of the lower half, labelled UNW to DSE, the root of an octree is NO_OCTANT
+#define NO_OCTANT 8
+
+#define TRACE_INIT_SIZE 32  // initial number of codes a trace can hold
+
+// quadrants visited by a query, one byte per quadrant
+// a NULL trace_t* disables tracing
+typedef struct trace {
+    unsigned char* codes;
+    int n;  // codes in the trace
+    int size;  // codes the trace can hold before growing
+} trace_t;
+
+// creates and returns an empty trace
+trace_t* traceCreate();
+
+// appends quadrant `code` to `trace`, does nothing if `trace` is NULL
+void traceAppend(trace_t* trace, int code);
+
+// empties `trace` keeping its buffer so it can be reused by the next query
+void traceReset(trace_t* trace);
+
+// returns the label of quadrant `code`
+char* quadrantLabel(int code);
+
+// function to print the labels of the quadrants in `trace` to `outFile`
+void tracePrint(trace_t* trace, FILE* outFile);
+
+// function to print the labels of the octants in `trace` to `outFile`
+void tracePrintOctants(trace_t* trace, FILE* outFile);
+
+// function to free allocated memory used by `trace`
+void traceFree(trace_t* trace);
+
+#endif
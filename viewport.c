@@ -0,0 +1,135 @@
+/* Project: PR QuadTrees
+* viewport.c :
+*            = implementation of the module viewport of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "viewport.h"
+#include "quadtree.h"
+#include "array.h"
+
+// state shared by every node of a viewport delta query
+typedef struct viewportDelta {
+    rectangle_t* previous;  // NULL for no previous viewport
+    rectangle_t* current;
+    array_t* entered;  // may hold a footpath once per point
+    array_t* left;  // may hold a footpath once per point
+    viewportStats_t* stats;
+} viewportDelta_t;
+
+// returns whether the part of `span` within `range` has a point outside of `other`
+// borders included, with no range holding nothing
+static int viewportUncovers(rectangle_t* span, rectangle_t* range, rectangle_t* other) {
+    if (range == NULL)
+        return 0;
+
+    rectangle_t overlap;
+    overlap.botLeftX = span->botLeftX > range->botLeftX ? span->botLeftX : range->botLeftX;
+    overlap.botLeftY = span->botLeftY > range->botLeftY ? span->botLeftY : range->botLeftY;
+    overlap.topRightX = span->topRightX < range->topRightX ? span->topRightX : range->topRightX;
+    overlap.topRightY = span->topRightY < range->topRightY ? span->topRightY : range->topRightY;
+
+    if (overlap.botLeftX > overlap.topRightX || overlap.botLeftY > overlap.topRightY)
+        return 0;
+
+    return other == NULL || overlap.botLeftX < other->botLeftX || overlap.topRightX > other->topRightX ||
+        overlap.botLeftY < other->botLeftY || overlap.topRightY > other->topRightY;
+}
+
+// returns whether `range` holds `point`, borders included, with no range holding nothing
+static int viewportHolds(rectangle_t* range, double x, double y) {
+    point_t point = {x, y};
+    return range != NULL && inRectangleStage4(range, &point);
+}
+
+// returns whether either point of `footpath` is within `range`
+static int viewportHoldsFootpath(rectangle_t* range, footpath_t* footpath) {
+    return viewportHolds(range, footpathGetStartLon(footpath), footpathGetStartLat(footpath)) ||
+        viewportHolds(range, footpathGetEndLon(footpath), footpathGetEndLat(footpath));
+}
+
+// recursively finds the footpaths below `node` entering or leaving the viewport of `delta`
+// a node with no points in one viewport that aren't also in the other is skipped
+static void viewportDeltaNode(viewportDelta_t* delta, qTreeNode_t* node) {
+    rectangle_t* span = node->rectangle;
+    if (node->count == 0 || (!viewportUncovers(span, delta->current, delta->previous) &&
+                             !viewportUncovers(span, delta->previous, delta->current)))
+        return;
+
+    delta->stats->nodesVisited++;
+
+    if (node->point != NULL) {
+        delta->stats->pointsTested++;
+        int inPrevious = viewportHolds(delta->previous, node->point->x, node->point->y);
+        int inCurrent = viewportHolds(delta->current, node->point->x, node->point->y);
+        if (inPrevious == inCurrent)
+            return;
+
+        // a footpath only enters or leaves if its other point doesn't keep it in view
+        for (int i = 0; i < node->footpaths->n; i++) {
+            footpath_t* footpath = node->footpaths->A[i];
+            if (inCurrent && !viewportHoldsFootpath(delta->previous, footpath))
+                arrayAppend(delta->entered, footpath);
+            else if (inPrevious && !viewportHoldsFootpath(delta->current, footpath))
+                arrayAppend(delta->left, footpath);
+        }
+        return;
+    }
+
+    if (node->NW) {
+        viewportDeltaNode(delta, node->NW);
+        viewportDeltaNode(delta, node->NE);
+        viewportDeltaNode(delta, node->SW);
+        viewportDeltaNode(delta, node->SE);
+    }
+}
+
+// appends the footpaths of `found` to `results` sorted by footpathID, each footpath once
+static void viewportAppendUnique(array_t* found, array_t* results) {
+    arraySort(found);
+    for (int i = 0; i < found->n; i++) {
+        if (i == 0 || footpathGetID(found->A[i]) != footpathGetID(found->A[i - 1]))
+            arrayAppend(results, found->A[i]);
+    }
+}
+
+// finds how the footpaths with a point within a viewport change as it moves from
+// `previous`, NULL for none, to `current`, borders included as in queryRange
+// stores footpaths no point of which was within `previous` into `entered` and
+// footpaths no point of which is within `current` into `left`, both sorted by
+// footpathID, and what the query cost into `stats`
+// only the parts of `qTree` within one viewport and not the other are walked,
+// the other point of a footpath found there is checked against both viewports
+void qTreeViewportDelta(qTree_t* qTree, rectangle_t* previous, rectangle_t* current,
+                        array_t* entered, array_t* left, viewportStats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    viewportDelta_t delta;
+    delta.previous = previous;
+    delta.current = current;
+    delta.entered = arrayCreate();
+    delta.left = arrayCreate();
+    delta.stats = stats;
+
+    viewportDeltaNode(&delta, qTree->root);
+
+    // both points of a footpath may have moved in or out of view
+    viewportAppendUnique(delta.entered, entered);
+    viewportAppendUnique(delta.left, left);
+
+    arrayFreeShallow(delta.entered);
+    arrayFreeShallow(delta.left);
+}
+
+// prints `stats` to `outFile`
+void viewportStatsPrint(viewportStats_t* stats, FILE* outFile) {
+    fprintf(outFile, "nodes visited: %d || points tested: %d\n",
+            stats->nodesVisited, stats->pointsTested);
+}
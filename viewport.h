@@ -0,0 +1,37 @@
+/* Project: PR QuadTrees
+* viewport.h :
+*            = interface of the module viewport of the project
+*
+* Created by Ayush Tyagi (ayusht@student.unimelb.edu.au)
+* 19/10/2026
+*
+* ----------------------------------------------------------------*/
+#ifndef _VIEWPORT_H_
+#define _VIEWPORT_H_
+
+#include <stdio.h>
+
+#include "data.h"
+#include "quadtree.h"
+#include "array.h"
+
+// what a viewport delta query cost
+typedef struct viewportStats {
+    int nodesVisited;  // nodes overlapping the part of a viewport not covered by the other
+    int pointsTested;  // points tested against both viewports
+} viewportStats_t;
+
+// finds how the footpaths with a point within a viewport change as it moves from
+// `previous`, NULL for none, to `current`, borders included as in queryRange
+// stores footpaths no point of which was within `previous` into `entered` and
+// footpaths no point of which is within `current` into `left`, both sorted by
+// footpathID, and what the query cost into `stats`
+// only the parts of `qTree` within one viewport and not the other are walked,
+// the other point of a footpath found there is checked against both viewports
+void qTreeViewportDelta(qTree_t* qTree, rectangle_t* previous, rectangle_t* current,
+                        array_t* entered, array_t* left, viewportStats_t* stats);
+
+// prints `stats` to `outFile`
+void viewportStatsPrint(viewportStats_t* stats, FILE* outFile);
+
+#endif